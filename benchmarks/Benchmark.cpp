@@ -0,0 +1,592 @@
+#define VOLK_IMPLEMENTATION
+
+#include "Renderer/Renderer.h"
+#include "Renderer/Model/Model.h"
+#include "Renderer/Material/Material.h"
+#include "Renderer/Shader/Shader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Runs the renderer headlessly through a set of fixed scenes and reports frame timings and renderer counters
+// as JSON. Results can be compared against a stored baseline, in which case the process fails (returns 1) if
+// any scene regressed by more than the allowed threshold or has no baseline to compare against. A missing
+// baseline is an error unless --update-baseline is passed.
+//
+// To benchmark on a software rasteriser (such as lavapipe), point VK_ICD_FILENAMES at its ICD manifest.
+
+struct Scene
+{
+    std::string name;
+    u32 cubes = 0;
+    u32 vases = 0;
+    u32 billboards = 0;
+    u32 lines = 0;
+    u32 sprites = 0;
+};
+
+struct Options
+{
+    std::vector<Scene> scenes;
+    u32 frames = 500;
+    u32 warmupFrames = 60;
+    u32 width = 1280;
+    u32 height = 720;
+    std::string outputPath = "bench_results.json";
+    std::string baselinePath;
+    float threshold = 10.f;
+    bool updateBaseline = false;
+};
+
+struct Timings
+{
+    float min = 0.f;
+    float average = 0.f;
+    float median = 0.f;
+    float p99 = 0.f;
+};
+
+struct SceneResult
+{
+    Scene scene;
+    Timings cpuFrameMs;
+    float gpuFrameMs = 0.f;
+    std::vector<std::pair<std::string, SnekVk::GpuProfiler::Stats>> passes;
+    // Counters summed over every measured frame.
+    SnekVk::RendererStats counters;
+    u32 countedFrames = 0;
+};
+
+static const std::vector<Scene> DEFAULT_SCENES = {
+    {"models", 400, 400, 0, 0, 0},
+    {"billboards", 0, 0, 1000, 0, 0},
+    {"lines", 0, 0, 0, 4000, 0},
+    {"sprites", 0, 0, 0, 0, 1000},
+    {"mixed", 200, 200, 250, 1000, 250}
+};
+
+static SnekVk::Vertex2D spriteVerts[] = {
+    {{1.f, 1.f}, {1.f, 0.f, 0.f}},
+    {{1.f, -1.f}, {1.f, 0.f, 0.f}},
+    {{-1.f, -1.f}, {1.f, 0.f, 0.f}},
+    {{-1.f, 1.f}, {1.f, 0.f, 0.f}},
+};
+
+static u32 spriteIndices[] = {
+    0, 1, 3, 1, 2, 3
+};
+
+static SnekVk::Mesh::MeshData spriteMeshData {
+    sizeof(SnekVk::Vertex2D),
+    spriteVerts,
+    4,
+    spriteIndices,
+    6
+};
+
+static void PrintUsage()
+{
+    std::cout << "Usage: bench [options]\n"
+              << "  --scene <name>        only run a built-in scene (models, billboards, lines, sprites, mixed)\n"
+              << "  --cubes <n>           run a custom scene with n cubes (likewise --vases, --billboards,\n"
+              << "                        --lines and --sprites)\n"
+              << "  --frames <n>          measured frames per scene (default 500)\n"
+              << "  --warmup <n>          unmeasured frames before each scene (default 60)\n"
+              << "  --width <n>           offscreen image width (default 1280)\n"
+              << "  --height <n>          offscreen image height (default 720)\n"
+              << "  --output <path>       where to write results (default bench_results.json)\n"
+              << "  --baseline <path>     compare against a baseline, which must exist unless updating it\n"
+              << "  --threshold <percent> allowed slowdown before failing (default 10)\n"
+              << "  --update-baseline     overwrite the baseline with these results" << std::endl;
+}
+
+static bool ParseOptions(int argc, char** argv, OUT Options& options)
+{
+    Scene custom {"custom"};
+    bool hasCustomScene = false;
+    std::string sceneName;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--update-baseline") { options.updateBaseline = true; continue; }
+        if (arg == "--help") return false;
+
+        if (i + 1 >= argc)
+        {
+            std::cout << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const char* value = argv[++i];
+        u32 count = static_cast<u32>(std::strtoul(value, nullptr, 10));
+
+        if (arg == "--scene") sceneName = value;
+        else if (arg == "--cubes") { custom.cubes = count; hasCustomScene = true; }
+        else if (arg == "--vases") { custom.vases = count; hasCustomScene = true; }
+        else if (arg == "--billboards") { custom.billboards = count; hasCustomScene = true; }
+        else if (arg == "--lines") { custom.lines = count; hasCustomScene = true; }
+        else if (arg == "--sprites") { custom.sprites = count; hasCustomScene = true; }
+        else if (arg == "--frames") options.frames = std::max(count, 1u);
+        else if (arg == "--warmup") options.warmupFrames = count;
+        else if (arg == "--width") options.width = std::max(count, 1u);
+        else if (arg == "--height") options.height = std::max(count, 1u);
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--baseline") options.baselinePath = value;
+        else if (arg == "--threshold") options.threshold = std::strtof(value, nullptr);
+        else
+        {
+            std::cout << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (hasCustomScene)
+    {
+        options.scenes.push_back(custom);
+        return true;
+    }
+
+    for (auto& scene : DEFAULT_SCENES)
+    {
+        if (sceneName.empty() || scene.name == sceneName) options.scenes.push_back(scene);
+    }
+
+    if (options.scenes.empty())
+    {
+        std::cout << "Unknown scene: " << sceneName << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Keeps scenes within the fixed capacities of the renderers.
+static void ClampScene(Scene& scene)
+{
+    auto clamp = [&](u32& value, u32 max, const char* name) {
+        if (value <= max) return;
+        std::cout << "Scene " << scene.name << " has too many " << name << ", clamping to " << max << std::endl;
+        value = max;
+    };
+
+    u32 maxModels = static_cast<u32>(SnekVk::ModelRenderer::MAX_OBJECT_TRANSFORMS);
+
+    clamp(scene.cubes, maxModels, "cubes");
+    clamp(scene.vases, maxModels - scene.cubes, "vases");
+    clamp(scene.billboards, static_cast<u32>(SnekVk::BillboardRenderer::MAX_BILLBOARDS), "billboards");
+    clamp(scene.sprites, static_cast<u32>(SnekVk::Renderer2D::MAX_OBJECT_TRANSFORMS), "sprites");
+}
+
+// Returns the position of an object laid out on a square grid centred on the origin.
+static glm::vec3 GridPosition(u32 index, u32 count, float spacing, float height)
+{
+    u32 side = static_cast<u32>(std::ceil(std::sqrt(static_cast<float>(std::max(count, 1u)))));
+    float offset = (static_cast<float>(side) - 1.f) * spacing * .5f;
+
+    return {
+        static_cast<float>(index % side) * spacing - offset,
+        height,
+        static_cast<float>(index / side) * spacing - offset
+    };
+}
+
+static void DrawScene(const Scene& scene, SnekVk::Model& cube, SnekVk::Model& vase, SnekVk::Model& sprite)
+{
+    for (u32 i = 0; i < scene.cubes; i++)
+    {
+        SnekVk::Renderer3D::DrawModel(&cube, GridPosition(i, scene.cubes, 1.5f, 0.f), glm::vec3{.5f});
+    }
+
+    for (u32 i = 0; i < scene.vases; i++)
+    {
+        SnekVk::Renderer3D::DrawModel(&vase, GridPosition(i, scene.vases, 1.5f, -1.f), glm::vec3{2.f});
+    }
+
+    for (u32 i = 0; i < scene.billboards; i++)
+    {
+        SnekVk::Renderer3D::DrawBillboard(GridPosition(i, scene.billboards, 1.f, -3.f), {.5f, .5f}, {1.f, 1.f, 1.f, 1.f});
+    }
+
+    for (u32 i = 0; i < scene.lines; i++)
+    {
+        float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(scene.lines);
+        glm::vec3 destination {std::cos(angle) * 10.f, -2.f, std::sin(angle) * 10.f};
+
+        SnekVk::Renderer3D::DrawLine({0.f, -2.f, 0.f}, destination, {1.f, 1.f, 1.f});
+    }
+
+    for (u32 i = 0; i < scene.sprites; i++)
+    {
+        glm::vec3 position = GridPosition(i, scene.sprites, .1f, 0.f);
+        SnekVk::Renderer2D::DrawModel(&sprite, {position.x, position.z}, {.04f, .04f}, 0.f);
+    }
+}
+
+// The camera orbits the origin once per scene, so every run renders exactly the same frames.
+static void UpdateCamera(SnekVk::Camera& camera, float aspect, u32 frame, u32 frameCount)
+{
+    float angle = glm::two_pi<float>() * static_cast<float>(frame) / static_cast<float>(frameCount);
+
+    camera.SetPerspectiveProjection(glm::radians(50.f), aspect, 0.1f, 100.f);
+    camera.SetViewTarget({std::cos(angle) * 25.f, -10.f, std::sin(angle) * 25.f}, {0.f, 0.f, 0.f});
+}
+
+static Timings CalculateTimings(std::vector<float> samples)
+{
+    Timings timings;
+
+    if (samples.empty()) return timings;
+
+    std::sort(samples.begin(), samples.end());
+
+    float total = 0.f;
+    for (auto sample : samples) total += sample;
+
+    timings.min = samples.front();
+    timings.average = total / static_cast<float>(samples.size());
+    timings.median = samples[samples.size() / 2];
+    timings.p99 = samples[(samples.size() - 1) * 99 / 100];
+
+    return timings;
+}
+
+static void AccumulateStats(const SnekVk::RendererStats& frame, OUT SnekVk::RendererStats& total)
+{
+    total.drawCalls += frame.drawCalls;
+    total.verticesDrawn += frame.verticesDrawn;
+    total.pipelineBinds += frame.pipelineBinds;
+    total.descriptorSetBinds += frame.descriptorSetBinds;
+    total.vertexBufferBinds += frame.vertexBufferBinds;
+    total.indexBufferBinds += frame.indexBufferBinds;
+    total.bufferUploads += frame.bufferUploads;
+    total.bytesUploaded += frame.bytesUploaded;
+    total.stagingCopies += frame.stagingCopies;
+    total.singleTimeSubmits += frame.singleTimeSubmits;
+}
+
+static SceneResult RunScene(
+    SnekVk::Renderer& renderer,
+    SnekVk::Camera& camera,
+    const Options& options,
+    const Scene& scene,
+    SnekVk::Model& cube,
+    SnekVk::Model& vase,
+    SnekVk::Model& sprite)
+{
+    SceneResult result;
+    result.scene = scene;
+
+    std::vector<float> frameTimes;
+    frameTimes.reserve(options.frames);
+
+    u32 totalFrames = options.warmupFrames + options.frames;
+
+    for (u32 frame = 0; frame < totalFrames; frame++)
+    {
+        // Every frame from the previous scene has been read back by now, so only this scene is measured.
+        if (frame == options.warmupFrames) SnekVk::GpuProfiler::ClearHistory();
+
+        auto start = std::chrono::steady_clock::now();
+
+        UpdateCamera(camera, renderer.GetAspectRatio(), frame, totalFrames);
+
+        if (!renderer.StartFrame()) continue;
+
+        DrawScene(scene, cube, vase, sprite);
+
+        renderer.EndFrame();
+
+        auto end = std::chrono::steady_clock::now();
+
+        if (frame >= options.warmupFrames)
+        {
+            frameTimes.push_back(std::chrono::duration<float, std::chrono::milliseconds::period>(end - start).count());
+
+            AccumulateStats(renderer.GetStats(), OUT result.counters);
+            result.countedFrames++;
+        }
+    }
+
+    result.cpuFrameMs = CalculateTimings(frameTimes);
+
+    for (auto name : SnekVk::GpuProfiler::GetScopeNames())
+    {
+        auto stats = SnekVk::GpuProfiler::GetStats(name);
+
+        if (stats.sampleCount == 0) continue;
+
+        result.gpuFrameMs += stats.average;
+        result.passes.emplace_back(name, stats);
+    }
+
+    std::sort(result.passes.begin(), result.passes.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    return result;
+}
+
+static std::string ToJson(const Options& options, const std::vector<SceneResult>& results)
+{
+    std::ostringstream json;
+
+    json << "{\n  \"frames\": " << options.frames
+         << ",\n  \"width\": " << options.width
+         << ",\n  \"height\": " << options.height
+         << ",\n  \"scenes\": [";
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& result = results[i];
+        auto& scene = result.scene;
+        auto& counters = result.counters;
+
+        // Counters are written as per-frame averages over the measured frames.
+        double frames = static_cast<double>(std::max(result.countedFrames, 1u));
+
+        json << (i == 0 ? "\n" : ",\n")
+             << "    {\n      \"name\": \"" << scene.name << "\""
+             << ",\n      \"cubes\": " << scene.cubes
+             << ",\n      \"vases\": " << scene.vases
+             << ",\n      \"billboards\": " << scene.billboards
+             << ",\n      \"lines\": " << scene.lines
+             << ",\n      \"sprites\": " << scene.sprites
+             << ",\n      \"cpuFrameMs\": {\"min\": " << result.cpuFrameMs.min
+             << ", \"average\": " << result.cpuFrameMs.average
+             << ", \"median\": " << result.cpuFrameMs.median
+             << ", \"p99\": " << result.cpuFrameMs.p99 << "}"
+             << ",\n      \"gpuFrameMs\": {\"average\": " << result.gpuFrameMs << "}"
+             << ",\n      \"passes\": {";
+
+        for (size_t j = 0; j < result.passes.size(); j++)
+        {
+            auto& pass = result.passes[j];
+
+            json << (j == 0 ? "" : ", ") << "\"" << pass.first << "\": {\"average\": " << pass.second.average
+                 << ", \"p99\": " << pass.second.p99;
+
+            if (pass.second.hasPipelineStatistics)
+            {
+                auto& statistics = pass.second.pipelineStatistics;
+                json << ", \"vertexInvocations\": " << statistics.vertexShaderInvocations
+                     << ", \"fragmentInvocations\": " << statistics.fragmentShaderInvocations
+                     << ", \"clippingPrimitives\": " << statistics.clippingPrimitives;
+            }
+
+            json << "}";
+        }
+
+        json << "}"
+             << ",\n      \"countersPerFrame\": {\"drawCalls\": " << counters.drawCalls / frames
+             << ", \"verticesDrawn\": " << counters.verticesDrawn / frames
+             << ", \"pipelineBinds\": " << counters.pipelineBinds / frames
+             << ", \"descriptorSetBinds\": " << counters.descriptorSetBinds / frames
+             << ", \"vertexBufferBinds\": " << counters.vertexBufferBinds / frames
+             << ", \"indexBufferBinds\": " << counters.indexBufferBinds / frames
+             << ", \"bufferUploads\": " << counters.bufferUploads / frames
+             << ", \"bytesUploaded\": " << counters.bytesUploaded / frames
+             << ", \"stagingCopies\": " << counters.stagingCopies / frames
+             << ", \"singleTimeSubmits\": " << counters.singleTimeSubmits / frames << "}"
+             << "\n    }";
+    }
+
+    json << "\n  ]\n}\n";
+
+    return json.str();
+}
+
+// Finds the average of a timing group within a scene in a results file. Returns a negative value if the
+// scene or timing isn't present. Only understands files written by ToJson().
+static float FindBaselineAverage(const std::string& json, const std::string& sceneName, const char* group)
+{
+    size_t sceneStart = json.find("\"name\": \"" + sceneName + "\"");
+
+    if (sceneStart == std::string::npos) return -1.f;
+
+    size_t sceneEnd = json.find("\"name\": ", sceneStart + 1);
+    size_t groupStart = json.find(std::string("\"") + group + "\"", sceneStart);
+
+    if (groupStart == std::string::npos || groupStart > sceneEnd) return -1.f;
+
+    size_t average = json.find("\"average\": ", groupStart);
+
+    if (average == std::string::npos || average > sceneEnd) return -1.f;
+
+    return std::strtof(json.c_str() + average + std::strlen("\"average\": "), nullptr);
+}
+
+static bool WriteFile(const std::string& path, const std::string& contents)
+{
+    std::ofstream file(path, std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        std::cout << "Failed to write to: " << path << std::endl;
+        return false;
+    }
+
+    file << contents;
+    return true;
+}
+
+// Returns true if every scene has a baseline and none is slower than it by more than the threshold.
+static bool CompareWithBaseline(const std::string& baseline, const std::vector<SceneResult>& results, float threshold)
+{
+    bool passed = true;
+
+    for (auto& result : results)
+    {
+        if (FindBaselineAverage(baseline, result.scene.name, "cpuFrameMs") > 0.f) continue;
+
+        std::cout << "MISSING    " << result.scene.name << ": no baseline (run with --update-baseline)" << std::endl;
+        passed = false;
+    }
+
+    auto compare = [&](const std::string& scene, const char* group, float current) {
+        float previous = FindBaselineAverage(baseline, scene, group);
+
+        // Timings which weren't recorded (such as GPU times on devices without timestamps) can't regress.
+        if (previous <= 0.f || current <= 0.f) return;
+
+        float change = (current - previous) / previous * 100.f;
+        bool regressed = change > threshold;
+
+        std::cout << (regressed ? "REGRESSION " : "           ") << scene << " " << group << ": "
+                  << previous << "ms -> " << current << "ms (" << (change >= 0.f ? "+" : "") << change << "%)" << std::endl;
+
+        if (regressed) passed = false;
+    };
+
+    for (auto& result : results)
+    {
+        compare(result.scene.name, "cpuFrameMs", result.cpuFrameMs.average);
+        compare(result.scene.name, "gpuFrameMs", result.gpuFrameMs);
+    }
+
+    return passed;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, OUT options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    SnekVk::Renderer renderer({options.width, options.height});
+
+    // Profiling markers are only needed if a trace is written, which the benchmark never does.
+    SnekVk::CpuProfiler::SetEnabled(false);
+
+    SnekVk::Camera camera;
+    renderer.SetMainCamera(&camera);
+
+    auto diffuseShader = SnekVk::Shader::BuildShader()
+        .FromShader("shaders/simpleShader.vert.spv")
+        .WithStage(SnekVk::PipelineConfig::VERTEX)
+        .WithVertexType(sizeof(SnekVk::Vertex))
+        .WithVertexAttribute(offsetof(SnekVk::Vertex, position), SnekVk::VertexDescription::VEC3)
+        .WithVertexAttribute(offsetof(SnekVk::Vertex, color), SnekVk::VertexDescription::VEC3)
+        .WithVertexAttribute(offsetof(SnekVk::Vertex, normal), SnekVk::VertexDescription::VEC3)
+        .WithVertexAttribute(offsetof(SnekVk::Vertex, uv), SnekVk::VertexDescription::VEC2)
+        .WithStorage(0, "objectBuffer", sizeof(SnekVk::Model::Transform), 1000)
+        .WithUniform(1, "globalData", sizeof(SnekVk::Renderer3D::GlobalData), 1);
+
+    auto spriteShader = SnekVk::Shader::BuildShader()
+        .FromShader("shaders/simpleShader2D.vert.spv")
+        .WithStage(SnekVk::PipelineConfig::VERTEX)
+        .WithVertexType(sizeof(SnekVk::Vertex2D))
+        .WithVertexAttribute(offsetof(SnekVk::Vertex2D, position), SnekVk::VertexDescription::VEC2)
+        .WithVertexAttribute(offsetof(SnekVk::Vertex2D, color), SnekVk::VertexDescription::VEC3)
+        .WithStorage(0, "objectBuffer", sizeof(SnekVk::Model::Transform2D), 1000)
+        .WithUniform(1, "globalData", sizeof(SnekVk::Renderer2D::GlobalData));
+
+    auto fragShader = SnekVk::Shader::BuildShader()
+        .FromShader("shaders/simpleShader.frag.spv")
+        .WithStage(SnekVk::PipelineConfig::FRAGMENT);
+
+    auto diffuseFragShader = SnekVk::Shader::BuildShader()
+        .FromShader("shaders/diffuseFragShader.frag.spv")
+        .WithStage(SnekVk::PipelineConfig::FRAGMENT)
+        .WithUniform(1, "globalData", sizeof(SnekVk::Renderer3D::GlobalData))
+        .WithStorage(2, "instanceData", sizeof(glm::vec4), 100);
+
+    SnekVk::Material diffuseMat(&diffuseShader, &diffuseFragShader);
+    SnekVk::Material spriteMat(&spriteShader, &fragShader);
+
+    diffuseMat.SetInstanceParameters("instanceData", sizeof(glm::vec4));
+
+    SnekVk::Material::BuildMaterials({&diffuseMat, &spriteMat});
+
+    SnekVk::Model cubeModel("assets/models/cube.obj");
+    SnekVk::Model vaseModel("assets/models/smooth_vase.obj");
+    SnekVk::Model spriteModel(spriteMeshData);
+
+    cubeModel.SetMaterial(&diffuseMat);
+    vaseModel.SetMaterial(&diffuseMat);
+    spriteModel.SetMaterial(&spriteMat);
+
+    std::vector<SceneResult> results;
+
+    for (auto scene : options.scenes)
+    {
+        ClampScene(scene);
+
+        std::cout << "Running scene: " << scene.name << std::endl;
+        results.push_back(RunScene(renderer, camera, options, scene, cubeModel, vaseModel, spriteModel));
+    }
+
+    renderer.ClearDeviceQueue();
+
+    cubeModel.DestroyModel();
+    vaseModel.DestroyModel();
+    spriteModel.DestroyModel();
+
+    std::string json = ToJson(options, results);
+
+    std::cout << json;
+
+    if (!WriteFile(options.outputPath, json)) return 2;
+
+    if (options.baselinePath.empty()) return 0;
+
+    if (options.updateBaseline)
+    {
+        std::cout << "Writing baseline to: " << options.baselinePath << std::endl;
+        return WriteFile(options.baselinePath, json) ? 0 : 2;
+    }
+
+    std::ifstream baselineFile(options.baselinePath);
+
+    // Silently recording a new baseline would let a fresh checkout pass regardless of its results.
+    if (!baselineFile.is_open())
+    {
+        std::cout << "No baseline found at: " << options.baselinePath
+                  << " (run with --update-baseline to record one)" << std::endl;
+        return 2;
+    }
+
+    std::stringstream baseline;
+    baseline << baselineFile.rdbuf();
+
+    if (!CompareWithBaseline(baseline.str(), results, options.threshold))
+    {
+        std::cout << "Benchmark failed: regressions exceed " << options.threshold << "%" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Benchmark passed" << std::endl;
+
+    return 0;
+}
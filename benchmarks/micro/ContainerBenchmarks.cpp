@@ -0,0 +1,167 @@
+#include "MicroBenchmark.h"
+
+#include "Renderer/Utils/Array.h"
+#include "Renderer/Utils/StackArray.h"
+
+// Sizes match the renderers' per-frame containers: object transforms are capped at 1000 and mesh
+// vertices at 10000.
+static constexpr size_t TRANSFORM_CAPACITY = 1000;
+static constexpr size_t VERTEX_CAPACITY = 10000;
+
+// The same size as a model transform (a 4x4 and a 3x3 matrix).
+struct Transform
+{
+    float values[25];
+};
+
+struct LineVertex
+{
+    float position[3];
+    float colour[3];
+};
+
+static SnekVk::Utils::StackArray<Transform, TRANSFORM_CAPACITY> transforms;
+static SnekVk::Utils::StackArray<LineVertex, VERTEX_CAPACITY> vertices;
+
+// Appends a frame's worth of elements and then clears them, as the renderers do every frame.
+static void StackArrayAppendClear(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+    Transform transform {};
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            transform.values[0] = static_cast<float>(i);
+            transforms.Append(transform);
+        }
+
+        MicroBench::ClobberMemory();
+        transforms.Clear();
+    }
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(StackArrayAppendClear, 16, 256, 1000);
+
+static void StackArrayAppendClearVertices(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+    LineVertex vertex {};
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            vertex.position[0] = static_cast<float>(i);
+            vertices.Append(vertex);
+        }
+
+        MicroBench::ClobberMemory();
+        vertices.Clear();
+    }
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(StackArrayAppendClearVertices, 64, 2000, 9999);
+
+// Clearing an array which only holds a few elements, which is the common case for most renderers.
+static void StackArrayClear(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+    LineVertex vertex {};
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (size_t i = 0; i < count; i++) vertices.Append(vertex);
+        state.ResumeTiming();
+
+        vertices.Clear();
+        MicroBench::ClobberMemory();
+    }
+}
+MICRO_BENCHMARK(StackArrayClear, 2, 2000);
+
+static void StackArrayIterate(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+
+    transforms.Clear();
+    for (size_t i = 0; i < count; i++) transforms.Append({{static_cast<float>(i)}});
+
+    for (auto _ : state)
+    {
+        float total = 0.f;
+
+        for (auto& transform : transforms) total += transform.values[0];
+
+        MicroBench::DoNotOptimize(total);
+    }
+
+    transforms.Clear();
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(StackArrayIterate, 16, 256, 1000);
+
+// Indexed access goes through Get(), which checks that the element exists.
+static void StackArrayIndexedGet(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+
+    transforms.Clear();
+    for (size_t i = 0; i < count; i++) transforms.Append({{static_cast<float>(i)}});
+
+    for (auto _ : state)
+    {
+        float total = 0.f;
+
+        for (size_t i = 0; i < transforms.Count(); i++) total += transforms.Get(i).values[0];
+
+        MicroBench::DoNotOptimize(total);
+    }
+
+    transforms.Clear();
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(StackArrayIndexedGet, 16, 256, 1000);
+
+static void ArrayIterate(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+
+    SnekVk::Utils::Array<float> array(count);
+    for (size_t i = 0; i < count; i++) array[i] = static_cast<float>(i);
+
+    for (auto _ : state)
+    {
+        float total = 0.f;
+
+        for (auto value : array) total += value;
+
+        MicroBench::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(ArrayIterate, 16, 1000, 10000);
+
+static void ArrayCopy(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+
+    SnekVk::Utils::Array<float> array(count);
+    for (size_t i = 0; i < count; i++) array[i] = static_cast<float>(i);
+
+    for (auto _ : state)
+    {
+        SnekVk::Utils::Array<float> copy(array);
+        MicroBench::DoNotOptimize(copy.Data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(ArrayCopy, 16, 1000, 10000);
@@ -0,0 +1,163 @@
+#include "MicroBenchmark.h"
+
+#include "Renderer/Utils/Hash.h"
+#include "Renderer/Mesh/Mesh.h"
+
+#include <glm/gtx/hash.hpp>
+
+#include <unordered_map>
+
+static const char* SHORT_NAMES[] = { "globalData", "objectBuffer", "positions", "instanceData" };
+
+// The longest names used as string ids are around this size.
+static const char* LONG_NAME = "Renderer3D::ModelRenderer::objectBuffer";
+
+// Vertices are hashed exactly as the OBJ loader does when de-duplicating them.
+static size_t HashVertex(const SnekVk::Vertex& vertex)
+{
+    size_t seed = 0;
+    SnekVk::Utils::HashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
+    return seed;
+}
+
+struct VertexHash
+{
+    size_t operator()(const SnekVk::Vertex& vertex) const { return HashVertex(vertex); }
+};
+
+struct VertexEqual
+{
+    bool operator()(const SnekVk::Vertex& left, const SnekVk::Vertex& right) const
+    {
+        return left.position == right.position && left.color == right.color &&
+               left.normal == right.normal && left.uv == right.uv;
+    }
+};
+
+static SnekVk::Vertex MakeVertex(size_t index)
+{
+    float value = static_cast<float>(index);
+    return { {value, value * .5f, -value}, {1.f, 1.f, 1.f}, {0.f, 1.f, 0.f}, {value * .1f, value * .2f} };
+}
+
+static void StringIdShort(MicroBench::State& state)
+{
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(SnekVk::Utils::WSID(SHORT_NAMES[index++ & 3]));
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+MICRO_BENCHMARK(StringIdShort);
+
+static void StringIdLong(MicroBench::State& state)
+{
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(SnekVk::Utils::WSID(LONG_NAME));
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+MICRO_BENCHMARK(StringIdLong);
+
+static void Crc32(MicroBench::State& state)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(state.Argument()));
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 31);
+
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(SnekVk::Utils::crc32(data.data(), data.size()));
+    }
+
+    state.SetItemsProcessed(state.Iterations() * data.size());
+}
+MICRO_BENCHMARK(Crc32, 16, 256, 1024, 65536);
+
+static void Crc32Sliced(MicroBench::State& state)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(state.Argument()));
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 31);
+
+    if (SnekVk::Utils::Crc32Sliced(data.data(), data.size()) != SnekVk::Utils::crc32(data.data(), data.size()))
+    {
+        std::cout << "Crc32Sliced does not match crc32!" << std::endl;
+        std::abort();
+    }
+
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(SnekVk::Utils::Crc32Sliced(data.data(), data.size()));
+    }
+
+    state.SetItemsProcessed(state.Iterations() * data.size());
+}
+MICRO_BENCHMARK(Crc32Sliced, 16, 256, 1024, 65536);
+
+static void Hash64(MicroBench::State& state)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(state.Argument()));
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 31);
+
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(SnekVk::Utils::Hash64(data.data(), data.size()));
+    }
+
+    state.SetItemsProcessed(state.Iterations() * data.size());
+}
+MICRO_BENCHMARK(Hash64, 16, 256, 1024, 65536);
+
+static void HashCombineVertex(MicroBench::State& state)
+{
+    SnekVk::Vertex vertices[64];
+    for (size_t i = 0; i < 64; i++) vertices[i] = MakeVertex(i);
+
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        MicroBench::DoNotOptimize(HashVertex(vertices[index++ & 63]));
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+MICRO_BENCHMARK(HashCombineVertex);
+
+// De-duplicates a mesh in which every vertex is shared by three faces, as in a typical OBJ file.
+static void VertexDeduplication(MicroBench::State& state)
+{
+    size_t count = static_cast<size_t>(state.Argument());
+
+    std::vector<SnekVk::Vertex> vertices;
+    vertices.reserve(count);
+    for (size_t i = 0; i < count; i++) vertices.push_back(MakeVertex(i / 3));
+
+    for (auto _ : state)
+    {
+        std::unordered_map<SnekVk::Vertex, uint32_t, VertexHash, VertexEqual> uniqueVertices;
+        std::vector<uint32_t> indices;
+        indices.reserve(count);
+
+        for (auto& vertex : vertices)
+        {
+            auto it = uniqueVertices.find(vertex);
+
+            if (it == uniqueVertices.end())
+            {
+                it = uniqueVertices.emplace(vertex, static_cast<uint32_t>(uniqueVertices.size())).first;
+            }
+
+            indices.push_back(it->second);
+        }
+
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * count);
+}
+MICRO_BENCHMARK(VertexDeduplication, 1000, 30000);
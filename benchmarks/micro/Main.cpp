@@ -0,0 +1,3 @@
+#include "MicroBenchmark.h"
+
+MICRO_BENCHMARK_MAIN();
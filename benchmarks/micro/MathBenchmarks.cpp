@@ -0,0 +1,66 @@
+#include "MicroBenchmark.h"
+
+#include "Renderer/Utils/Math.h"
+
+#include <vector>
+
+struct Object
+{
+    glm::vec3 position;
+    glm::vec3 rotation;
+    glm::vec3 scale;
+};
+
+static std::vector<Object> MakeObjects(size_t count)
+{
+    std::vector<Object> objects(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        float value = static_cast<float>(i);
+        objects[i] = { {value, -value, value * .5f}, {value * .01f, value * .02f, value * .03f}, {1.f, 2.f, 1.f} };
+    }
+
+    return objects;
+}
+
+// Builds the model and normal matrices for a frame's worth of objects, as the model renderer does.
+static void CalculateTransform3D(MicroBench::State& state)
+{
+    auto objects = MakeObjects(static_cast<size_t>(state.Argument()));
+    std::vector<glm::mat4> transforms(objects.size());
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            auto& object = objects[i];
+            transforms[i] = SnekVk::Utils::Math::CalculateTransform3D(object.position, object.rotation, object.scale);
+        }
+
+        MicroBench::DoNotOptimize(transforms.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * objects.size());
+}
+MICRO_BENCHMARK(CalculateTransform3D, 1, 1000);
+
+static void CalculateNormalMatrix(MicroBench::State& state)
+{
+    auto objects = MakeObjects(static_cast<size_t>(state.Argument()));
+    std::vector<glm::mat3> normals(objects.size());
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            auto& object = objects[i];
+            normals[i] = SnekVk::Utils::Math::CalculateNormalMatrix(object.rotation, object.scale);
+        }
+
+        MicroBench::DoNotOptimize(normals.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * objects.size());
+}
+MICRO_BENCHMARK(CalculateNormalMatrix, 1, 1000);
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A minimal, header-only microbenchmark harness modelled on Google Benchmark. Benchmarks are free functions
+// which loop over a State, registered with MICRO_BENCHMARK:
+//
+//     static void Append(MicroBench::State& state)
+//     {
+//         for (auto _ : state) { ... }
+//         state.SetItemsProcessed(state.Iterations() * state.Argument());
+//     }
+//     MICRO_BENCHMARK(Append, 64, 1024);
+//
+// Each benchmark is run once per argument. The iteration count is grown until a run takes at least the
+// minimum time, and that run is then repeated to report the fastest, median and mean time per iteration.
+
+#define MICRO_BENCH_CONCAT_IMPL(a, b) a##b
+#define MICRO_BENCH_CONCAT(a, b) MICRO_BENCH_CONCAT_IMPL(a, b)
+
+#define MICRO_BENCHMARK(function, ...) \
+    static MicroBench::Registrar MICRO_BENCH_CONCAT(microBenchRegistrar, __LINE__)(#function, function, {__VA_ARGS__})
+
+#define MICRO_BENCHMARK_MAIN() \
+    int main(int argc, char** argv) { return MicroBench::RunAll(argc, argv); }
+
+namespace MicroBench
+{
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Prevents the compiler from optimising away the computation of a value.
+     */
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Forces all pending writes to memory to be treated as observable.
+     */
+    inline void ClobberMemory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    class State
+    {
+        public:
+
+        State(uint64_t iterations, int64_t argument) : iterations{iterations}, argument{argument} {}
+
+        class Iterator
+        {
+            public:
+
+            Iterator(State* state, uint64_t remaining) : state{state}, remaining{remaining} {}
+
+            bool operator!=(const Iterator&)
+            {
+                if (remaining != 0) return true;
+
+                state->StopTimer();
+                return false;
+            }
+
+            void operator++() { remaining--; }
+            int operator*() const { return 0; }
+
+            private:
+
+            State* state;
+            uint64_t remaining;
+        };
+
+        Iterator begin()
+        {
+            StartTimer();
+            return Iterator(this, iterations);
+        }
+
+        Iterator end() { return Iterator(this, 0); }
+
+        /**
+         * @brief Stops timing, so that setup work inside the loop isn't measured.
+         */
+        void PauseTiming() { StopTimer(); }
+
+        void ResumeTiming() { StartTimer(); }
+
+        uint64_t Iterations() const { return iterations; }
+        int64_t Argument() const { return argument; }
+
+        void SetItemsProcessed(uint64_t items) { itemsProcessed = items; }
+        uint64_t ItemsProcessed() const { return itemsProcessed; }
+
+        double ElapsedSeconds() const { return std::chrono::duration<double>(elapsed).count(); }
+
+        private:
+
+        void StartTimer()
+        {
+            start = Clock::now();
+            isTiming = true;
+        }
+
+        void StopTimer()
+        {
+            if (!isTiming) return;
+
+            elapsed += Clock::now() - start;
+            isTiming = false;
+        }
+
+        uint64_t iterations;
+        int64_t argument;
+        uint64_t itemsProcessed {0};
+
+        Clock::time_point start;
+        Clock::duration elapsed {0};
+        bool isTiming {false};
+    };
+
+    typedef void (*Function)(State&);
+
+    struct Benchmark
+    {
+        std::string name;
+        Function function;
+        std::vector<int64_t> arguments;
+    };
+
+    inline std::vector<Benchmark>& Registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, Function function, std::initializer_list<int64_t> arguments)
+        {
+            Registry().push_back({name, function, arguments});
+        }
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        double minNs = 0.0;
+        double medianNs = 0.0;
+        double meanNs = 0.0;
+        // Items per second, based on the median run. Zero if the benchmark doesn't report items.
+        double itemsPerSecond = 0.0;
+    };
+
+    struct Options
+    {
+        std::string filter;
+        std::string outputPath;
+        double minTime = 0.2;
+        uint32_t repetitions = 5;
+    };
+
+    inline Result Run(const Benchmark& benchmark, int64_t argument, bool hasArgument, const Options& options)
+    {
+        Result result;
+        result.name = hasArgument ? benchmark.name + "/" + std::to_string(argument) : benchmark.name;
+
+        // Grow the iteration count until a single run is long enough to time reliably.
+        uint64_t iterations = 1;
+
+        while (true)
+        {
+            State state(iterations, argument);
+            benchmark.function(state);
+
+            double elapsed = state.ElapsedSeconds();
+
+            if (elapsed >= options.minTime || iterations >= (1ull << 40)) break;
+
+            double scale = elapsed > 0.0 ? (options.minTime * 1.4) / elapsed : 10.0;
+            iterations = static_cast<uint64_t>(static_cast<double>(iterations) * std::min(std::max(scale, 2.0), 10.0));
+        }
+
+        std::vector<double> times;
+        std::vector<uint64_t> items;
+
+        for (uint32_t i = 0; i < std::max(options.repetitions, 1u); i++)
+        {
+            State state(iterations, argument);
+            benchmark.function(state);
+
+            times.push_back(state.ElapsedSeconds() * 1e9 / static_cast<double>(iterations));
+            items.push_back(state.ItemsProcessed());
+        }
+
+        std::vector<double> sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+
+        double total = 0.0;
+        for (auto time : times) total += time;
+
+        result.iterations = iterations;
+        result.minNs = sorted.front();
+        result.medianNs = sorted[sorted.size() / 2];
+        result.meanNs = total / static_cast<double>(times.size());
+
+        double itemsPerIteration = static_cast<double>(items.front()) / static_cast<double>(iterations);
+        if (itemsPerIteration > 0.0) result.itemsPerSecond = itemsPerIteration * 1e9 / result.medianNs;
+
+        return result;
+    }
+
+    inline std::string ToJson(const std::vector<Result>& results)
+    {
+        std::ostringstream json;
+
+        #ifdef __OPTIMIZE__
+        bool isOptimised = true;
+        #else
+        bool isOptimised = false;
+        #endif
+
+        #ifdef NDEBUG
+        bool hasAssertions = false;
+        #else
+        bool hasAssertions = true;
+        #endif
+
+        json << "{\n  \"optimised\": " << (isOptimised ? "true" : "false")
+             << ",\n  \"assertions\": " << (hasAssertions ? "true" : "false")
+             << ",\n  \"benchmarks\": [";
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            auto& result = results[i];
+
+            json << (i == 0 ? "\n" : ",\n")
+                 << "    {\"name\": \"" << result.name << "\""
+                 << ", \"iterations\": " << result.iterations
+                 << ", \"minNs\": " << result.minNs
+                 << ", \"medianNs\": " << result.medianNs
+                 << ", \"meanNs\": " << result.meanNs
+                 << ", \"itemsPerSecond\": " << result.itemsPerSecond << "}";
+        }
+
+        json << "\n  ]\n}\n";
+
+        return json.str();
+    }
+
+    inline bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+
+            if (i + 1 >= argc)
+            {
+                std::cout << "Usage: microbench [--filter <substring>] [--min-time <seconds>] "
+                          << "[--repetitions <n>] [--output <path>]" << std::endl;
+                return false;
+            }
+
+            const char* value = argv[++i];
+
+            if (arg == "--filter") options.filter = value;
+            else if (arg == "--min-time") options.minTime = std::strtod(value, nullptr);
+            else if (arg == "--repetitions") options.repetitions = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (arg == "--output") options.outputPath = value;
+            else
+            {
+                std::cout << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline int RunAll(int argc, char** argv)
+    {
+        Options options;
+
+        if (!ParseOptions(argc, argv, options)) return 2;
+
+        #ifndef __OPTIMIZE__
+        std::cout << "WARNING: microbenchmarks were built without optimisations, results will not be representative"
+                  << std::endl;
+        #endif
+
+        std::vector<Result> results;
+
+        for (auto& benchmark : Registry())
+        {
+            std::vector<int64_t> arguments = benchmark.arguments;
+            bool hasArguments = !arguments.empty();
+
+            if (!hasArguments) arguments.push_back(0);
+
+            for (auto argument : arguments)
+            {
+                std::string name = hasArguments ? benchmark.name + "/" + std::to_string(argument) : benchmark.name;
+
+                if (!options.filter.empty() && name.find(options.filter) == std::string::npos) continue;
+
+                auto result = Run(benchmark, argument, hasArguments, options);
+
+                std::cout << result.name << ": " << result.medianNs << " ns (min " << result.minNs << " ns";
+
+                if (result.itemsPerSecond > 0.0) std::cout << ", " << result.itemsPerSecond / 1e6 << " M items/s";
+
+                std::cout << ")" << std::endl;
+
+                results.push_back(result);
+            }
+        }
+
+        std::string json = ToJson(results);
+
+        if (options.outputPath.empty())
+        {
+            std::cout << json;
+            return 0;
+        }
+
+        std::ofstream file(options.outputPath, std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            std::cout << "Failed to write to: " << options.outputPath << std::endl;
+            return 2;
+        }
+
+        file << json;
+
+        std::cout << "Wrote results to: " << options.outputPath << std::endl;
+
+        return 0;
+    }
+}
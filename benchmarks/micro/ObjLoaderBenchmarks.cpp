@@ -0,0 +1,314 @@
+#include "MicroBenchmark.h"
+
+#include "Renderer/Model/MeshCache.h"
+#include "Renderer/Model/MeshOptimiser.h"
+#include "Renderer/Model/ObjLoader.h"
+#include "Renderer/Model/VertexTable.h"
+#include "Renderer/Utils/MappedFile.h"
+
+#include <glm/gtx/hash.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+// The side length of the generated grid, in vertices. This makes a file of roughly 6MB.
+static constexpr size_t GRID_SIZE = 192;
+
+/**
+ * Generates a height field with positions, normals and texture coordinates, written with the same
+ * precision as a typical exporter. Half the cells are quads and the other half are pairs of triangles.
+ */
+static const std::string& GetObjData()
+{
+    static std::string data;
+
+    if (!data.empty()) return data;
+
+    char line[128];
+
+    for (size_t y = 0; y < GRID_SIZE; y++)
+    {
+        for (size_t x = 0; x < GRID_SIZE; x++)
+        {
+            float u = static_cast<float>(x) / (GRID_SIZE - 1);
+            float v = static_cast<float>(y) / (GRID_SIZE - 1);
+            float height = std::sin(u * 12.f) * std::cos(v * 9.f) * .25f;
+
+            std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", u * 2.f - 1.f, height, v * 2.f - 1.f);
+            data += line;
+
+            std::snprintf(line, sizeof(line), "vn %.4f %.4f %.4f\n", -height * .3f, .95f, height * .2f);
+            data += line;
+
+            std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", u, v);
+            data += line;
+        }
+    }
+
+    for (size_t y = 0; y + 1 < GRID_SIZE; y++)
+    {
+        for (size_t x = 0; x + 1 < GRID_SIZE; x++)
+        {
+            size_t a = y * GRID_SIZE + x + 1, b = a + 1, c = a + GRID_SIZE + 1, d = a + GRID_SIZE;
+
+            if ((x + y) & 1)
+            {
+                std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n",
+                              a, a, a, b, b, b, c, c, c, d, d, d);
+                data += line;
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, b, b, b, c, c, c);
+                data += line;
+                std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, c, c, c, d, d, d);
+                data += line;
+            }
+        }
+    }
+
+    return data;
+}
+
+// Parses the generated file with the given number of threads, reporting throughput in bytes.
+static void ObjParse(MicroBench::State& state)
+{
+    auto& data = GetObjData();
+    auto threadCount = static_cast<u32>(state.Argument());
+
+    std::vector<SnekVk::Vertex> vertices, expectedVertices;
+    std::vector<u32> indices, expectedIndices;
+    std::string error;
+
+    std::istringstream stream(data);
+    SnekVk::ObjLoader::LoadWithTinyObj(stream, expectedVertices, expectedIndices, error);
+
+    bool isParsed = SnekVk::ObjLoader::Parse(data.data(), data.size(), vertices, indices, threadCount);
+
+    if (!isParsed || indices != expectedIndices || vertices.size() != expectedVertices.size() ||
+        std::memcmp(vertices.data(), expectedVertices.data(), vertices.size() * sizeof(SnekVk::Vertex)) != 0)
+    {
+        std::cout << "ObjLoader output does not match tinyobjloader!" << std::endl;
+        std::abort();
+    }
+
+    for (auto _ : state)
+    {
+        SnekVk::ObjLoader::Parse(data.data(), data.size(), vertices, indices, threadCount);
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * data.size());
+}
+MICRO_BENCHMARK(ObjParse, 1, 2, 4, 8);
+
+static void ObjParseTinyObj(MicroBench::State& state)
+{
+    auto& data = GetObjData();
+
+    std::vector<SnekVk::Vertex> vertices;
+    std::vector<u32> indices;
+    std::string error;
+
+    for (auto _ : state)
+    {
+        std::istringstream stream(data);
+        SnekVk::ObjLoader::LoadWithTinyObj(stream, vertices, indices, error);
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * data.size());
+}
+MICRO_BENCHMARK(ObjParseTinyObj);
+
+// Loads one of the sample models. Microbenchmarks are run from the repository root.
+static void ObjParseSmoothVase(MicroBench::State& state)
+{
+    SnekVk::Utils::MappedFile file("assets/models/smooth_vase.obj");
+
+    if (!file.IsOpen())
+    {
+        std::cout << "Could not open assets/models/smooth_vase.obj" << std::endl;
+        return;
+    }
+
+    std::vector<SnekVk::Vertex> vertices;
+    std::vector<u32> indices;
+
+    for (auto _ : state)
+    {
+        SnekVk::ObjLoader::Parse(file.Data(), file.Size(), vertices, indices);
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * file.Size());
+}
+MICRO_BENCHMARK(ObjParseSmoothVase);
+
+// Loads the same model from a mesh cache, copying it into memory the way it would be copied into a staging buffer.
+static void MeshCacheLoadSmoothVase(MicroBench::State& state)
+{
+    const char* sourcePath = "assets/models/smooth_vase.obj";
+    const char* cachePath = "bin/smooth_vase.obj.snekmesh";
+
+    SnekVk::Utils::MappedFile file(sourcePath);
+    std::string error;
+
+    if (!file.IsOpen() || !SnekVk::MeshCache::Cook(sourcePath, cachePath, SnekVk::MeshCache::FLAG_OPTIMISED, error))
+    {
+        std::cout << "Could not cook " << sourcePath << " " << error << std::endl;
+        return;
+    }
+
+    u64 sourceHash = SnekVk::MeshCache::HashSource(file);
+    std::vector<char> stagingData;
+
+    for (auto _ : state)
+    {
+        SnekVk::MeshCache::MappedMesh mesh;
+        mesh.Open(cachePath, sourceHash, SnekVk::MeshCache::FLAG_OPTIMISED);
+
+        auto meshData = mesh.GetMeshData();
+        size_t vertexBytes = meshData.vertexCount * meshData.vertexSize;
+
+        stagingData.resize(vertexBytes + meshData.indexCount * sizeof(u32));
+        std::memcpy(stagingData.data(), meshData.vertices, vertexBytes);
+        std::memcpy(stagingData.data() + vertexBytes, meshData.indices, meshData.indexCount * sizeof(u32));
+
+        MicroBench::DoNotOptimize(stagingData.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * file.Size());
+}
+MICRO_BENCHMARK(MeshCacheLoadSmoothVase);
+
+// Runs every optimisation pass over the generated file, reporting throughput in triangles.
+static void MeshOptimise(MicroBench::State& state)
+{
+    auto& data = GetObjData();
+
+    std::vector<SnekVk::Vertex> sourceVertices, vertices;
+    std::vector<u32> sourceIndices, indices;
+
+    SnekVk::ObjLoader::Parse(data.data(), data.size(), sourceVertices, sourceIndices);
+
+    for (auto _ : state)
+    {
+        vertices = sourceVertices;
+        indices = sourceIndices;
+
+        SnekVk::MeshOptimiser::Optimise(vertices, indices);
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * sourceIndices.size() / 3);
+}
+MICRO_BENCHMARK(MeshOptimise);
+
+/**
+ * Returns the corners of a grid mesh with roughly the given number of triangles, in the order an OBJ
+ * file would list them. Each interior vertex is shared by six triangles.
+ */
+static const std::vector<SnekVk::Vertex>& GetMeshCorners(size_t triangleCount)
+{
+    static std::map<size_t, std::vector<SnekVk::Vertex>> meshes;
+
+    auto& corners = meshes[triangleCount];
+
+    if (!corners.empty()) return corners;
+
+    auto gridSize = static_cast<size_t>(std::sqrt(static_cast<double>(triangleCount / 2))) + 1;
+
+    auto vertexAt = [gridSize](size_t x, size_t y) {
+        float u = static_cast<float>(x) / (gridSize - 1);
+        float v = static_cast<float>(y) / (gridSize - 1);
+        return SnekVk::Vertex { {u, std::sin(u * 12.f) * .25f, v}, {1.f, 1.f, 1.f}, {0.f, 1.f, 0.f}, {u, v} };
+    };
+
+    corners.reserve((gridSize - 1) * (gridSize - 1) * 6);
+
+    for (size_t y = 0; y + 1 < gridSize; y++)
+    {
+        for (size_t x = 0; x + 1 < gridSize; x++)
+        {
+            corners.insert(corners.end(), { vertexAt(x, y), vertexAt(x + 1, y), vertexAt(x + 1, y + 1) });
+            corners.insert(corners.end(), { vertexAt(x, y), vertexAt(x + 1, y + 1), vertexAt(x, y + 1) });
+        }
+    }
+
+    return corners;
+}
+
+struct MapVertexHash
+{
+    size_t operator()(const SnekVk::Vertex& vertex) const
+    {
+        size_t seed = 0;
+        SnekVk::Utils::HashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
+        return seed;
+    }
+};
+
+struct MapVertexEqual
+{
+    bool operator()(const SnekVk::Vertex& left, const SnekVk::Vertex& right) const
+    {
+        return left.position == right.position && left.color == right.color &&
+               left.normal == right.normal && left.uv == right.uv;
+    }
+};
+
+// De-duplicates vertices through std::unordered_map, looking each one up with count() and then operator[].
+static void DedupUnorderedMap(MicroBench::State& state)
+{
+    auto& corners = GetMeshCorners(static_cast<size_t>(state.Argument()));
+
+    std::vector<SnekVk::Vertex> vertices;
+    std::vector<u32> indices;
+
+    for (auto _ : state)
+    {
+        std::unordered_map<SnekVk::Vertex, u32, MapVertexHash, MapVertexEqual> uniqueVertices;
+
+        vertices.clear();
+        indices.clear();
+
+        for (auto& vertex : corners)
+        {
+            if (uniqueVertices.count(vertex) == 0)
+            {
+                uniqueVertices[vertex] = static_cast<u32>(vertices.size());
+                vertices.push_back(vertex);
+            }
+
+            indices.push_back(uniqueVertices[vertex]);
+        }
+
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * corners.size());
+}
+MICRO_BENCHMARK(DedupUnorderedMap, 100000, 1000000);
+
+static void DedupVertexTable(MicroBench::State& state)
+{
+    auto& corners = GetMeshCorners(static_cast<size_t>(state.Argument()));
+
+    std::vector<u32> indices(corners.size());
+
+    for (auto _ : state)
+    {
+        SnekVk::VertexTable uniqueVertices(corners.size());
+
+        for (size_t i = 0; i < corners.size(); i++) indices[i] = uniqueVertices.FindOrInsert(corners[i]);
+
+        MicroBench::DoNotOptimize(indices.data());
+    }
+
+    state.SetItemsProcessed(state.Iterations() * corners.size());
+}
+MICRO_BENCHMARK(DedupVertexTable, 100000, 1000000);
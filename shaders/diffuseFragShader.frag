@@ -19,11 +19,24 @@ struct LightData
     vec3 position;
 };
 
+struct InstanceData
+{
+    vec4 tint;
+};
+
 layout (set = 1, binding = 1) uniform GlobalData {
     CameraData cameraData;
     LightData lightData;
 } globalData;
 
+layout (std140, set = 2, binding = 2) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+} instanceBuffer;
+
+layout (push_constant) uniform Instance {
+    uint index;
+} instance;
+
 LightData lightData = globalData.lightData;
 
 void main() {
@@ -33,5 +46,6 @@ void main() {
     vec3 lightColor = lightData.lightColor.xyz * lightData.lightColor.w * attenuation;
     vec3 ambientLight = lightData.ambientLightColor.xyz * lightData.ambientLightColor.w;
     vec3 diffuseLight = lightColor * max(dot(normalize(fragNormalWorld), normalize(directionToLight)), 0);
-    outColor = vec4((diffuseLight + ambientLight) * fragColor, 1.0);
+    vec4 tint = instanceBuffer.instances[instance.index].tint;
+    outColor = vec4((diffuseLight + ambientLight) * fragColor * tint.rgb, tint.a);
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Buffer.h"
+#include "../DeletionQueue/DeletionQueue.h"
+#include "../Profiling/RenderStatistics.h"
 
 namespace SnekVk::Buffer
 {
@@ -46,6 +48,9 @@ namespace SnekVk::Buffer
         vkMapMemory(device, dstBuffer.bufferMemory, offset, size, 0, &data);
         memcpy(data, bufferData, size);
         vkUnmapMemory(device, dstBuffer.bufferMemory);
+
+        RenderStatistics::Increment(RenderStatistics::BUFFER_UPLOADS);
+        RenderStatistics::Increment(RenderStatistics::BYTES_UPLOADED, size);
     }
 
     void AppendData(Buffer& dstBuffer, VkDeviceSize size, const void* bufferData)
@@ -57,6 +62,9 @@ namespace SnekVk::Buffer
         memcpy(data, bufferData, size);
         vkUnmapMemory(device, dstBuffer.bufferMemory);
 
+        RenderStatistics::Increment(RenderStatistics::BUFFER_UPLOADS);
+        RenderStatistics::Increment(RenderStatistics::BYTES_UPLOADED, size);
+
         dstBuffer.size = dstBuffer.size + size;
     }
 
@@ -67,9 +75,17 @@ namespace SnekVk::Buffer
 
     void DestroyBuffer(Buffer& buffer)
     {
-        VkDevice device = VulkanDevice::GetDeviceInstance()->Device();
-        if (buffer.buffer != VK_NULL_HANDLE) vkDestroyBuffer(device, buffer.buffer, nullptr);
-        if (buffer.bufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, buffer.bufferMemory, nullptr);
+        VkBuffer vkBuffer = buffer.buffer;
+        VkDeviceMemory bufferMemory = buffer.bufferMemory;
+
+        DeletionQueue::Enqueue([vkBuffer, bufferMemory]() {
+            VkDevice device = VulkanDevice::GetDeviceInstance()->Device();
+            if (vkBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, vkBuffer, nullptr);
+            if (bufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, bufferMemory, nullptr);
+        });
+
+        buffer.buffer = VK_NULL_HANDLE;
+        buffer.bufferMemory = VK_NULL_HANDLE;
     }
 
     size_t PadUniformBufferSize(size_t originalSize)
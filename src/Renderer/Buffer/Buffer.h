@@ -62,7 +62,8 @@ namespace SnekVk::Buffer
     void CopyBuffer(VkBuffer& srcBuffer, VkBuffer& dstBuffer, VkDeviceSize size);
 
     /**
-     * Destroys a buffer struct and releases memory back to the device. 
+     * Destroys a buffer struct and releases memory back to the device. Destruction
+     * is deferred until all frames which may be using the buffer have completed.
      * 
      * @param buffer - the buffer to be destroyed.
      **/
@@ -3,6 +3,7 @@
 #include "Utils/Array.h"
 #include "Utils/StackArray.h"
 #include "Utils/Hash.h"
+#include "Logging/Logger.h"
 
 #include <volk/volk.h>
 #include <iostream>
@@ -14,6 +15,8 @@
 #include <glm/glm.hpp>
 
 // Custom type declarations
+typedef uint8_t u8;
+typedef uint16_t u16;
 typedef uint32_t u32;
 typedef uint64_t u64;
 typedef int32_t i32;
@@ -21,7 +24,9 @@ typedef size_t size;
 
 #define EXIT_APP abort();
 
+// Queued log messages are written out first, so that they aren't lost when the app exits.
 #define REPORT_ASSERT_FAILURE(expr, file, line, message) \
+    SnekVk::Logger::Flush(); \
     std::cout << "SNEK ASSERTION FAILURE: " << #expr << " in file: " << file << " on line: "  << line << std::endl; \
     std::cout  << "                        Message: " << message << std::endl; 
 
@@ -36,7 +41,7 @@ typedef size_t size;
 
 #define OUT
 
-#define INTERN_STR(str) Utils::WSID(str)
+#define INTERN_STR(str) Utils::InternString(str)
 
 namespace SnekVk 
 {
@@ -0,0 +1,56 @@
+#include "DeletionQueue.h"
+
+#include <vector>
+
+namespace SnekVk
+{
+    std::deque<DeletionQueue::Entry> DeletionQueue::queue;
+    u64 DeletionQueue::currentFrame = 0;
+    std::mutex DeletionQueue::queueMutex;
+
+    void DeletionQueue::Enqueue(Deleter&& deleter)
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        queue.push_back({ currentFrame, std::move(deleter) });
+    }
+
+    void DeletionQueue::AdvanceFrame()
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        currentFrame++;
+    }
+
+    void DeletionQueue::Flush(u32 framesInFlight)
+    {
+        std::vector<Deleter> deleters;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+
+            // After waiting on the current frame's fence, every frame submitted at least 
+            // framesInFlight frames ago is guaranteed to have completed. Entries are queued
+            // in frame order, so we can stop at the first entry that's still in use.
+            while (!queue.empty() && queue.front().frame + framesInFlight <= currentFrame)
+            {
+                deleters.push_back(std::move(queue.front().deleter));
+                queue.pop_front();
+            }
+        }
+
+        for (auto& deleter : deleters) deleter();
+    }
+
+    void DeletionQueue::FlushAll()
+    {
+        std::deque<Entry> entries;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            entries.swap(queue);
+        }
+
+        for (auto& entry : entries) entry.deleter();
+    }
+}
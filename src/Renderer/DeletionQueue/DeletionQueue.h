@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../Core.h"
+
+#include <functional>
+#include <deque>
+#include <mutex>
+
+namespace SnekVk
+{
+    /**
+     * @brief The DeletionQueue defers the destruction of Vulkan objects until the GPU is done with them.
+     * Resources destroyed while frames are in flight may still be referenced by those frames' command buffers,
+     * so instead of being destroyed immediately they are queued alongside the number of the frame that was
+     * being recorded at the time. 
+     * 
+     * Queued resources are destroyed once that frame's fence has signalled, meaning resources can be released 
+     * at runtime without stalling the device. 
+     */
+    class DeletionQueue
+    {
+        public:
+
+        typedef std::function<void()> Deleter;
+
+        /**
+         * @brief Queues a function which destroys one or more resources. The function is called once all frames 
+         * which may be using the resources have completed. 
+         * 
+         * @param deleter a function which destroys the resources. Handles should be captured by value.
+         */
+        static void Enqueue(Deleter&& deleter);
+
+        /**
+         * @brief Marks the current frame as submitted. Resources queued after this point belong to the next frame.
+         */
+        static void AdvanceFrame();
+
+        /**
+         * @brief Destroys all resources belonging to completed frames. Should be called after waiting on the 
+         * current frame's fence. 
+         * 
+         * @param framesInFlight the number of frames which can be in flight at once.
+         */
+        static void Flush(u32 framesInFlight);
+
+        /**
+         * @brief Destroys all queued resources regardless of which frame they belong to. Should only be called 
+         * once the device is idle.
+         */
+        static void FlushAll();
+
+        private:
+
+        struct Entry
+        {
+            u64 frame = 0;
+            Deleter deleter;
+        };
+
+        static std::deque<Entry> queue;
+        static u64 currentFrame;
+
+        static std::mutex queueMutex;
+    };
+}
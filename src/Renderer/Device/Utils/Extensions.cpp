@@ -37,12 +37,18 @@ namespace SnekVk::Extensions
         return true;
     }
 
-    std::vector<const char *> GetRequiredExtensions(bool enableValidationLayers) {
-        uint32_t glfwExtensionCount = 0;
-        const char **glfwExtensions;
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    std::vector<const char *> GetRequiredExtensions(bool enableValidationLayers, bool headless) {
+        std::vector<const char *> extensions;
 
-        std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        // Headless renderers never create a surface, so GLFW isn't needed (or initialised).
+        if (!headless)
+        {
+            uint32_t glfwExtensionCount = 0;
+            const char **glfwExtensions;
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         if (enableValidationLayers) {
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -51,7 +57,7 @@ namespace SnekVk::Extensions
         return extensions;
     }
 
-    void HasGflwRequiredInstanceExtensions(bool enableValidationLayers) 
+    void HasGflwRequiredInstanceExtensions(bool enableValidationLayers, bool headless) 
     {
         // Get an array of all available instance extensions.
         uint32_t extensionCount = 0;
@@ -59,20 +65,20 @@ namespace SnekVk::Extensions
         VkExtensionProperties extensions[extensionCount];
         vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, OUT extensions);
 
-        std::cout << "available extensions:" << std::endl;
+        SNEK_LOG_TRACE("available extensions:");
         std::unordered_set<std::string> available;
         for (size_t i = 0; i < extensionCount; i++) 
         {
             VkExtensionProperties extension = extensions[i];
-            std::cout << "\t" << extension.extensionName << std::endl;
+            SNEK_LOG_TRACE("\t" << extension.extensionName);
             available.insert(extension.extensionName);
         }
 
-        std::cout << "required extensions:" << std::endl;
-        auto requiredExtensions = GetRequiredExtensions(enableValidationLayers);
+        SNEK_LOG_TRACE("required extensions:");
+        auto requiredExtensions = GetRequiredExtensions(enableValidationLayers, headless);
         for (const auto &required : requiredExtensions) 
         {
-            std::cout << "\t" << required << std::endl;
+            SNEK_LOG_TRACE("\t" << required);
             SNEK_ASSERT(available.find(required) != available.end(), 
                 "Failed to find GLFW Extensions!");
         }
@@ -20,15 +20,18 @@ namespace SnekVk::Extensions
      * Compiles a list of all required extensions.
      * 
      * @param enableValidationLayers a boolean specifying if validation layers are enabled
+     * @param headless a boolean specifying if the renderer has no window. Headless renderers don't 
+     * need any of the windowing system's surface extensions. 
      * @returns a vector of required validation layers (represented as const chars) 
      **/
-    std::vector<const char *> GetRequiredExtensions(bool enableValidationLayers);
+    std::vector<const char *> GetRequiredExtensions(bool enableValidationLayers, bool headless = false);
 
     /**
      * Validates that all required extensions exist for our Vulkan instance. 
      * All required validation layers MUST exist, otherwise the program crashes. 
      * 
      * @param enableValidationLayers a boolian specifying if validation layers are enabled.
+     * @param headless a boolean specifying if the renderer has no window.
      **/
-    void HasGflwRequiredInstanceExtensions(bool enableValidationLayers);
+    void HasGflwRequiredInstanceExtensions(bool enableValidationLayers, bool headless = false);
 }
\ No newline at end of file
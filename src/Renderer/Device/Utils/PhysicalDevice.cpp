@@ -42,8 +42,9 @@ namespace SnekVk::PhysicalDevice
 
         bool extensionsSupported = CheckExtensionSupport(device, deviceExtensions, deviceExtensionCount);
 
-        bool swapChainAdequate = false;
-        if (extensionsSupported) 
+        // Headless devices never create a swapchain.
+        bool swapChainAdequate = surface == VK_NULL_HANDLE;
+        if (extensionsSupported && !swapChainAdequate) 
         {
             // Check if the device supports the image formats and present modes needed to render to the screen.
             SwapChainSupportDetails::SwapChainSupportDetails swapChainSupport = SwapChainSupportDetails::QuerySupport(device, surface);
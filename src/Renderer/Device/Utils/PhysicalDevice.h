@@ -26,7 +26,8 @@ namespace SnekVk::PhysicalDevice
      * Evaluates if a device is suitable for usage by the renderer.  
      * 
      * @param device the physical device being evaulated.
-     * @param surface the window surface to be rendered to.
+     * @param surface the window surface to be rendered to. If this is VK_NULL_HANDLE then swapchain 
+     * support isn't required. 
      * @param deviceExtensions the extensions which the device must support.
      * @param deviceExtensionCount the size of the deviceExtensions array.
      * @returns a boolean specifying if the device is suitable for usage.
@@ -25,7 +25,10 @@ namespace SnekVk::QueueFamilyIndices
             }
 
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, OUT &presentSupport);
+
+            // Without a surface nothing is presented, so any graphics queue will do.
+            if (surface == VK_NULL_HANDLE) presentSupport = indices.graphicsFamilyHasValue && indices.graphicsFamily == i;
+            else vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, OUT &presentSupport);
 
             if (queueFamily.queueCount > 0 && presentSupport) 
             {
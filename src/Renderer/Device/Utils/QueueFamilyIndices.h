@@ -26,7 +26,8 @@ namespace SnekVk::QueueFamilyIndices
     /**
      * Finds all the available queue indices for the given device. 
      * @param device the physical device required for finding queue indices. 
-     * @param surface the window surface to render images to. 
+     * @param surface the window surface to render images to. If this is VK_NULL_HANDLE then the renderer 
+     * is headless, and the graphics queue is used in place of a present queue. 
      * @returns a QueueFamilyIndices struct containing the queue indices for graphics and presentation.
      **/
     QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR& surface);
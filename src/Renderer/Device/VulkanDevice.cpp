@@ -1,4 +1,5 @@
 #include "VulkanDevice.h"
+#include "../Profiling/RenderStatistics.h"
 
 // std headers
 #include <cstring>
@@ -46,6 +47,21 @@ namespace SnekVk {
 		SetVulkanDeviceInstance(this);
 	}
 
+	void VulkanDevice::InitialiseHeadless()
+	{
+		SNEK_ASSERT(volkInitialize() == VK_SUCCESS, "Unable to initialise Volk!");
+
+		headless = true;
+
+		CreateInstance();
+		SetupDebugMessenger();
+		PickPhysicalDevice();
+		CreateLogicalDevice();
+		CreateCommandPool();
+
+		SetVulkanDeviceInstance(this);
+	}
+
 	VulkanDevice::~VulkanDevice() 
 	{
 		// When the device goes out of scope, all vulkan structs must be 
@@ -59,7 +75,8 @@ namespace SnekVk {
 			DebugUtilsMessenger::DestroyMessenger(instance, debugMessenger, nullptr);
 		}
 
-		vkDestroySurfaceKHR(instance, surface, nullptr);
+		// Surface functions aren't loaded when running headless.
+		if (surface != VK_NULL_HANDLE) vkDestroySurfaceKHR(instance, surface, nullptr);
 		vkDestroyInstance(instance, nullptr);
 	}
 
@@ -85,7 +102,7 @@ namespace SnekVk {
 		createInfo.pApplicationInfo = &appInfo;
 
 		// Get all extensions required by our windowing system. 
-		auto extensions = Extensions::GetRequiredExtensions(enableValidationLayers);
+		auto extensions = Extensions::GetRequiredExtensions(enableValidationLayers, headless);
 		createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
 		createInfo.ppEnabledExtensionNames = extensions.data();
 
@@ -108,7 +125,7 @@ namespace SnekVk {
 		SNEK_ASSERT(vkCreateInstance(&createInfo, nullptr, OUT &instance) == VK_SUCCESS, 
 			"Unable to create Vulkan Instance!");
 
-		Extensions::HasGflwRequiredInstanceExtensions(enableValidationLayers);
+		Extensions::HasGflwRequiredInstanceExtensions(enableValidationLayers, headless);
 
 		volkLoadInstance(instance);
 	}
@@ -122,15 +139,18 @@ namespace SnekVk {
 
 		SNEK_ASSERT(deviceCount > 0, "Failed to find GPUs with Vulkan Support!");
 
-		std::cout << "Device count: " << deviceCount << std::endl;
+		SNEK_LOG_INFO("Device count: " << deviceCount);
 
 		VkPhysicalDevice devices[deviceCount];
 		vkEnumeratePhysicalDevices(instance, &deviceCount, OUT devices);
 
+		const char* const* extensions = headless ? headlessDeviceExtensions.data() : deviceExtensions.data();
+		size_t extensionCount = headless ? headlessDeviceExtensions.size() : deviceExtensions.size();
+
 		for (size_t i = 0; i < deviceCount; i++) 
 		{
 			VkPhysicalDevice device = devices[i];
-			if (PhysicalDevice::IsSuitable(device, surface, deviceExtensions.data(), deviceExtensions.size())) 
+			if (PhysicalDevice::IsSuitable(device, surface, extensions, extensionCount)) 
 			{
 				physicalDevice = device;
 				break;
@@ -140,8 +160,8 @@ namespace SnekVk {
 		SNEK_ASSERT(physicalDevice != VK_NULL_HANDLE, "Failed to find a suitable GPU!");
 
 		vkGetPhysicalDeviceProperties(physicalDevice, OUT &properties);
-		std::cout << "physical device: " << properties.deviceName << std::endl;
-		std::cout << "GPU has a minumum buffer alignment of " << properties.limits.minUniformBufferOffsetAlignment << std::endl;
+		SNEK_LOG_INFO("physical device: " << properties.deviceName);
+		SNEK_LOG_INFO("GPU has a minumum buffer alignment of " << properties.limits.minUniformBufferOffsetAlignment);
 	}
 
 	void VulkanDevice::CreateLogicalDevice() 
@@ -165,8 +185,15 @@ namespace SnekVk {
 			index++;
 		}
 
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, OUT &supportedFeatures);
+
 		VkPhysicalDeviceFeatures deviceFeatures = {};
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
+		// Only used for profiling, so it's enabled when available rather than required.
+		deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+
+		enabledFeatures = deviceFeatures;
 
 		VkDeviceCreateInfo createInfo = {};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -175,8 +202,8 @@ namespace SnekVk {
 		createInfo.pQueueCreateInfos = queueCreateInfos;
 
 		createInfo.pEnabledFeatures = &deviceFeatures;
-		createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(headless ? headlessDeviceExtensions.size() : deviceExtensions.size());
+		createInfo.ppEnabledExtensionNames = headless ? headlessDeviceExtensions.data() : deviceExtensions.data();
 
 		// might not really be necessary anymore because device specific validation layers
 		// have been deprecated
@@ -293,6 +320,8 @@ namespace SnekVk {
 		vkQueueWaitIdle(graphicsQueue);
 
 		vkFreeCommandBuffers(device, commandPool, 1, OUT &commandBuffer);
+
+		RenderStatistics::Increment(RenderStatistics::SINGLE_TIME_SUBMITS);
 	}
 
 	void VulkanDevice::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) 
@@ -304,6 +333,7 @@ namespace SnekVk {
 		copyRegion.dstOffset = 0;  // Optional
 		copyRegion.size = size;
 		vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+		RenderStatistics::Increment(RenderStatistics::STAGING_COPIES);
 
 		EndSingleTimeCommands(commandBuffer);
 	}
@@ -333,6 +363,8 @@ namespace SnekVk {
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1,
 			&region);
+		RenderStatistics::Increment(RenderStatistics::STAGING_COPIES);
+
 		EndSingleTimeCommands(commandBuffer);
 	}
 
@@ -47,6 +47,18 @@ namespace SnekVk {
 		static VulkanDevice* GetDeviceInstance() { return vulkanDeviceInstance; }
 
 		void SetWindow(Window* window);
+
+		/**
+		 * Initialises the device without a window. No surface is created and no swapchain or 
+		 * surface extensions are requested, so devices without present support (such as software 
+		 * rasterisers) can be used. The graphics queue doubles as the present queue. 
+		 **/
+		void InitialiseHeadless();
+
+		/**
+		 * Returns true if the device was initialised without a window. 
+		 **/
+		bool IsHeadless() const { return headless; }
 		
 		/**
 		 * Returns a copy of the command pool held by the device. 
@@ -63,6 +75,11 @@ namespace SnekVk {
 		 **/
 		VkDevice Device() { return device; }
 
+		/**
+		 * Returns a copy of the physical device (GPU) that the logical device was created from.
+		 **/
+		VkPhysicalDevice PhysicalDevice() { return physicalDevice; }
+
 		/**
 		 * Returns a copy of the window surface held by the VulkanDevice. 
 		 * A window surface represents the actual window we wish to draw to. Vulkan can't 
@@ -178,6 +195,11 @@ namespace SnekVk {
 		 **/
 		VkPhysicalDeviceProperties properties;
 
+		/**
+		 * The features which were enabled when the logical device was created. 
+		 **/
+		VkPhysicalDeviceFeatures enabledFeatures {};
+
 		private:
 		/**
 		 * Instantiates a Vulkan instance for the use of this renderer. 
@@ -259,10 +281,12 @@ namespace SnekVk {
 		VkCommandPool commandPool;
 
 		VkDevice device;
-		VkSurfaceKHR surface;
+		VkSurfaceKHR surface {VK_NULL_HANDLE};
 		VkQueue graphicsQueue;
 		VkQueue presentQueue;
 
+		bool headless {false};
+
 		/**
 		 * An array storing all required validation layers (if enabled).
 		 **/
@@ -272,6 +296,11 @@ namespace SnekVk {
 		 * An array storing all required extensions. All of these must be present for the renderer to start.
 		 **/
 		const std::array<const char*, 2> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME };
+
+		/**
+		 * The extensions required when running headless. These match deviceExtensions, minus the swapchain.
+		 **/
+		const std::array<const char*, 1> headlessDeviceExtensions = { VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME };
 	};
 
 }  // namespace lve
@@ -0,0 +1,28 @@
+#include "FrameAllocator.h"
+
+namespace SnekVk
+{
+    Utils::LinearAllocator FrameAllocator::arenas[SwapChain::MAX_FRAMES_IN_FLIGHT];
+    u32 FrameAllocator::currentArena = 0;
+    u64 FrameAllocator::frame = 0;
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        return arenas[currentArena].Allocate(size, alignment);
+    }
+
+    void FrameAllocator::EndFrame(u32 frameIndex)
+    {
+        SNEK_ASSERT(frameIndex < SwapChain::MAX_FRAMES_IN_FLIGHT, "Frame index is out of range!");
+
+        currentArena = frameIndex;
+        arenas[currentArena].Reset();
+
+        frame++;
+    }
+
+    void FrameAllocator::Destroy()
+    {
+        for (auto& arena : arenas) arena.Release();
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Swapchain/Swapchain.h"
+#include "../Utils/LinearAllocator.h"
+
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+namespace SnekVk
+{
+    /**
+     * @brief The FrameAllocator provides memory for transient data which only lives for a single frame, such
+     * as draw lists and generated vertices. Each frame in flight owns a linear arena, so allocations are a
+     * pointer bump and all of a frame's data is released at once when the frame ends.
+     *
+     * Arenas grow to fit the largest frame seen so far, so there's no hard limit on the amount of data
+     * a frame can allocate. Allocations must only be made from the thread recording the frame.
+     */
+    class FrameAllocator
+    {
+        public:
+
+        static void* Allocate(size_t size, size_t alignment);
+
+        template<typename T>
+        static T* Allocate(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Switches to the arena of the next frame in flight and resets it. Anything allocated during
+         * that frame's previous use is invalidated.
+         *
+         * @param frameIndex the index of the frame in flight which is about to be recorded.
+         */
+        static void EndFrame(u32 frameIndex);
+
+        /**
+         * @brief Frees the memory of all arenas.
+         */
+        static void Destroy();
+
+        // Incremented every time a frame ends. Used to detect allocations which outlived their frame.
+        static u64 GetFrame() { return frame; }
+
+        static size_t GetBytesAllocated() { return arenas[currentArena].BytesAllocated(); }
+
+        private:
+
+        static Utils::LinearAllocator arenas[SwapChain::MAX_FRAMES_IN_FLIGHT];
+        static u32 currentArena;
+        static u64 frame;
+    };
+
+    /**
+     * @brief A growable array whose storage is allocated from the FrameAllocator. When full, the array is
+     * moved into a block twice the size. Old blocks are simply abandoned, since the arena is released in bulk.
+     *
+     * Contents are only valid for the frame they were added in, so the array must be cleared before the frame
+     * ends. Elements must be trivially copyable, as they are moved with memcpy and never destroyed.
+     */
+    template<typename T>
+    class FrameArray
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "FrameArray elements must be trivially copyable");
+
+        public:
+        using ValueType = T;
+        using Iterator = T*;
+        using ConstIterator = const T*;
+
+        static constexpr size_t MIN_CAPACITY = 64;
+
+        public:
+
+        FrameArray() {}
+
+        FrameArray(const FrameArray<T>&) = delete;
+        FrameArray<T>& operator=(const FrameArray<T>&) = delete;
+
+        size_t Count() const { return count; }
+        size_t Capacity() const { return capacity; }
+        bool Empty() const { return count == 0; }
+
+        T* Data() { return data; }
+        const T* Data() const { return data; }
+
+        void Append(const T& value)
+        {
+            if (count == capacity) Reserve(count + 1);
+
+            data[count++] = value;
+        }
+
+        /**
+         * @brief Makes space for at least the given number of elements.
+         */
+        void Reserve(size_t required)
+        {
+            assert((data == nullptr || allocatedFrame == FrameAllocator::GetFrame())
+                && "Error: FrameArray was not cleared before the end of the frame!");
+
+            if (required <= capacity) return;
+
+            size_t newCapacity = capacity * 2;
+            if (newCapacity < required) newCapacity = required;
+            if (newCapacity < MIN_CAPACITY) newCapacity = MIN_CAPACITY;
+
+            T* newData = FrameAllocator::Allocate<T>(newCapacity);
+
+            if (count > 0) std::memcpy(newData, data, sizeof(T) * count);
+
+            data = newData;
+            capacity = newCapacity;
+            allocatedFrame = FrameAllocator::GetFrame();
+        }
+
+        T& Get(size_t index)
+        {
+            assert(index < count && "Error: index is out of bounds!");
+
+            return data[index];
+        }
+
+        const T& Get(size_t index) const
+        {
+            assert(index < count && "Error: index is out of bounds!");
+
+            return data[index];
+        }
+
+        T& Back() { return Get(count - 1); }
+        const T& Back() const { return Get(count - 1); }
+
+        T& operator[] (size_t index) { return Get(index); }
+        const T& operator[] (size_t index) const { return Get(index); }
+
+        Iterator begin() { return data; }
+        Iterator end() { return data + count; }
+
+        ConstIterator begin() const { return data; }
+        ConstIterator end() const { return data + count; }
+
+        /**
+         * @brief Empties the array and lets go of its storage, which is reclaimed when the frame ends.
+         */
+        void Clear()
+        {
+            data = nullptr;
+            count = 0;
+            capacity = 0;
+        }
+
+        private:
+
+        T* data {nullptr};
+        size_t count {0};
+        size_t capacity {0};
+        u64 allocatedFrame {0};
+    };
+}
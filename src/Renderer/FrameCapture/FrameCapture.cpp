@@ -0,0 +1,503 @@
+#include "FrameCapture.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace SnekVk
+{
+    FrameCapture::ReadbackSlot FrameCapture::slots[SwapChain::MAX_FRAMES_IN_FLIGHT];
+
+    u32 FrameCapture::framesToCapture = 0;
+    u32 FrameCapture::capturedFrames = 0;
+    std::string FrameCapture::capturePrefix;
+    FrameCapture::Format FrameCapture::captureFormat = FrameCapture::PNG;
+
+    std::string FrameCapture::goldenPath;
+    u8 FrameCapture::goldenTolerance = 0;
+    FrameCapture::ComparisonResult FrameCapture::comparisonResult;
+
+    std::deque<FrameCapture::Job> FrameCapture::jobs;
+    std::thread FrameCapture::worker;
+    std::mutex FrameCapture::jobMutex;
+    std::condition_variable FrameCapture::jobAdded;
+    std::condition_variable FrameCapture::jobsFinished;
+    bool FrameCapture::isProcessing = false;
+    bool FrameCapture::isRunning = false;
+
+    void FrameCapture::Initialise()
+    {
+        if (isRunning) return;
+
+        isRunning = true;
+        worker = std::thread(RunWorker);
+    }
+
+    void FrameCapture::Destroy()
+    {
+        if (!isRunning) return;
+
+        // The device is idle, so any outstanding copies have completed.
+        ProcessAllFrames();
+        WaitForWorker();
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            isRunning = false;
+        }
+
+        jobAdded.notify_all();
+        worker.join();
+
+        for (auto& slot : slots)
+        {
+            if (slot.buffer.buffer == VK_NULL_HANDLE) continue;
+
+            // Freeing the memory implicitly unmaps it.
+            Buffer::DestroyBuffer(slot.buffer);
+            slot = ReadbackSlot();
+        }
+    }
+
+    bool FrameCapture::CaptureFrames(const char* pathPrefix, u32 frameCount, Format format)
+    {
+        SNEK_ASSERT(isRunning, "FrameCapture must be initialised before capturing frames!");
+
+        // Without readback the request would never be consumed, leaving IsCapturing() true forever.
+        auto swapChain = SwapChain::GetInstance();
+
+        if (swapChain && !swapChain->SupportsReadback())
+        {
+            SNEK_LOG_WARNING("Cannot capture frames: the surface does not support TRANSFER_SRC usage");
+            return false;
+        }
+
+        if (capturePrefix != pathPrefix) capturedFrames = 0;
+
+        capturePrefix = pathPrefix;
+        captureFormat = format;
+        framesToCapture = frameCount;
+
+        return true;
+    }
+
+    void FrameCapture::CompareWithGolden(const char* goldenPath, u8 tolerance)
+    {
+        FrameCapture::goldenPath = goldenPath ? goldenPath : "";
+        goldenTolerance = tolerance;
+    }
+
+    FrameCapture::ComparisonResult FrameCapture::GetComparisonResult()
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        return comparisonResult;
+    }
+
+    void FrameCapture::RecordCopy(
+        VkCommandBuffer commandBuffer,
+        u32 frameIndex,
+        VkImage image,
+        VkImageLayout layout,
+        VkExtent2D extent,
+        VkFormat format)
+    {
+        if (!IsCapturing()) return;
+
+        auto& slot = slots[frameIndex];
+
+        // The fence for this frame has already been waited on, so any previous readback
+        // has been handed off by now.
+        SNEK_ASSERT(!slot.pending, "Frame readback was never processed!");
+
+        ResizeSlot(slot, extent);
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s_%05u", capturePrefix.c_str(), capturedFrames);
+
+        slot.format = format;
+        slot.path = path;
+        slot.fileFormat = captureFormat;
+        slot.pending = true;
+
+        capturedFrames++;
+        framesToCapture--;
+
+        // Wait for the render pass to finish writing before copying from the image. The render pass' final
+        // layout transition happens in its implicit external dependency, whose destination stage is
+        // BOTTOM_OF_PIPE. Only an ALL_COMMANDS source scope chains with that, so the copy is ordered after
+        // the transition as well as the writes.
+        VkImageMemoryBarrier toTransfer {};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer.oldLayout = layout;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = image;
+        toTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkBufferImageCopy region {};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { extent.width, extent.height, 1 };
+
+        vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer.buffer, 1, &region);
+
+        // Make the copy visible to the host once the frame's fence signals.
+        VkBufferMemoryBarrier toHost {};
+        toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.buffer = slot.buffer.buffer;
+        toHost.offset = 0;
+        toHost.size = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT,
+            0, 0, nullptr, 1, &toHost, 0, nullptr);
+
+        if (layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) return;
+
+        // Return the image to the layout it was left in by the render pass.
+        VkImageMemoryBarrier toOriginal = toTransfer;
+        toOriginal.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toOriginal.dstAccessMask = 0;
+        toOriginal.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toOriginal.newLayout = layout;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toOriginal);
+    }
+
+    void FrameCapture::ProcessFrame(u32 frameIndex)
+    {
+        auto& slot = slots[frameIndex];
+
+        if (slot.pending) SubmitSlot(slot);
+    }
+
+    void FrameCapture::ProcessAllFrames()
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.pending) SubmitSlot(slot);
+        }
+    }
+
+    void FrameCapture::WaitForWorker()
+    {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobsFinished.wait(lock, []{ return jobs.empty() && !isProcessing; });
+    }
+
+    void FrameCapture::ResizeSlot(ReadbackSlot& slot, VkExtent2D extent)
+    {
+        if (slot.buffer.buffer != VK_NULL_HANDLE && slot.extent.width == extent.width && slot.extent.height == extent.height)
+        {
+            return;
+        }
+
+        // Frames in flight can't be using this slot's buffer, but destruction is deferred regardless.
+        if (slot.buffer.buffer != VK_NULL_HANDLE) Buffer::DestroyBuffer(slot.buffer);
+
+        // All supported formats have four 8-bit channels.
+        VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+        // Coherent memory is guaranteed to exist, so the buffer never needs to be invalidated before reading.
+        Buffer::CreateBuffer(
+            size,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            OUT slot.buffer.buffer,
+            OUT slot.buffer.bufferMemory);
+
+        slot.buffer.size = size;
+        slot.extent = extent;
+
+        // Readback buffers stay mapped for their lifetime.
+        vkMapMemory(VulkanDevice::GetDeviceInstance()->Device(), slot.buffer.bufferMemory, 0, size, 0, OUT &slot.mappedData);
+    }
+
+    void FrameCapture::SubmitSlot(ReadbackSlot& slot)
+    {
+        Job job;
+        job.width = slot.extent.width;
+        job.height = slot.extent.height;
+        job.format = slot.format;
+        job.path = slot.path;
+        job.fileFormat = slot.fileFormat;
+        job.goldenPath = goldenPath;
+        job.tolerance = goldenTolerance;
+
+        // Copying out of the mapped buffer frees the slot up for the next capture straight away.
+        auto texels = static_cast<const u8*>(slot.mappedData);
+        job.texels.assign(texels, texels + slot.buffer.size);
+
+        slot.pending = false;
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobs.push_back(std::move(job));
+        }
+
+        jobAdded.notify_one();
+    }
+
+    void FrameCapture::RunWorker()
+    {
+        while (true)
+        {
+            Job job;
+
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobAdded.wait(lock, []{ return !jobs.empty() || !isRunning; });
+
+                if (jobs.empty() && !isRunning) return;
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                isProcessing = true;
+            }
+
+            ProcessJob(job);
+
+            {
+                std::lock_guard<std::mutex> lock(jobMutex);
+                isProcessing = false;
+            }
+
+            jobsFinished.notify_all();
+        }
+    }
+
+    void FrameCapture::ProcessJob(Job& job)
+    {
+        if (job.fileFormat == RAW)
+        {
+            WriteRaw((job.path + ".raw").c_str(), job.texels.data(), job.texels.size());
+        }
+
+        // Raw captures don't need converting unless they're being compared.
+        if (job.fileFormat == RAW && job.goldenPath.empty()) return;
+
+        auto rgb = ToRGB(job);
+
+        if (job.fileFormat == PPM) WritePPM((job.path + ".ppm").c_str(), rgb.data(), job.width, job.height);
+        else if (job.fileFormat == PNG) WritePNG((job.path + ".png").c_str(), rgb.data(), job.width, job.height);
+
+        if (!job.goldenPath.empty()) CompareGolden(job, rgb);
+    }
+
+    std::vector<u8> FrameCapture::ToRGB(const Job& job)
+    {
+        bool isBGR = job.format == VK_FORMAT_B8G8R8A8_SRGB || job.format == VK_FORMAT_B8G8R8A8_UNORM;
+
+        size_t pixelCount = static_cast<size_t>(job.width) * job.height;
+
+        std::vector<u8> rgb(pixelCount * 3);
+
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            const u8* texel = &job.texels[i * 4];
+            u8* pixel = &rgb[i * 3];
+
+            pixel[0] = isBGR ? texel[2] : texel[0];
+            pixel[1] = texel[1];
+            pixel[2] = isBGR ? texel[0] : texel[2];
+        }
+
+        return rgb;
+    }
+
+    void FrameCapture::WritePPM(const char* path, const u8* rgb, u32 width, u32 height)
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file.is_open())
+        {
+            SNEK_LOG_ERROR("Failed to open " << path << " for writing");
+            return;
+        }
+
+        file << "P6\n" << width << " " << height << "\n255\n";
+        file.write(reinterpret_cast<const char*>(rgb), static_cast<std::streamsize>(width) * height * 3);
+    }
+
+    void FrameCapture::WritePNG(const char* path, const u8* rgb, u32 width, u32 height)
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file.is_open())
+        {
+            SNEK_LOG_ERROR("Failed to open " << path << " for writing");
+            return;
+        }
+
+        auto writeU32 = [](std::vector<u8>& out, u32 value) {
+            out.push_back((value >> 24) & 0xFF);
+            out.push_back((value >> 16) & 0xFF);
+            out.push_back((value >> 8) & 0xFF);
+            out.push_back(value & 0xFF);
+        };
+
+        auto writeChunk = [&](const char* type, const std::vector<u8>& data) {
+            std::vector<u8> chunk;
+            chunk.reserve(data.size() + 12);
+
+            writeU32(chunk, static_cast<u32>(data.size()));
+            chunk.insert(chunk.end(), type, type + 4);
+            chunk.insert(chunk.end(), data.begin(), data.end());
+
+            // The CRC covers the chunk type and data.
+            writeU32(chunk, Utils::Crc32Sliced(chunk.data() + 4, chunk.size() - 4));
+
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        };
+
+        static const u8 signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        // 8-bit RGB, no interlacing.
+        std::vector<u8> header;
+        writeU32(header, width);
+        writeU32(header, height);
+        header.insert(header.end(), { 8, 2, 0, 0, 0 });
+        writeChunk("IHDR", header);
+
+        // Each scanline is prefixed with its filter type. No filtering is applied.
+        size_t rowSize = static_cast<size_t>(width) * 3;
+        std::vector<u8> scanlines;
+        scanlines.reserve((rowSize + 1) * height);
+
+        for (u32 y = 0; y < height; y++)
+        {
+            scanlines.push_back(0);
+            scanlines.insert(scanlines.end(), rgb + y * rowSize, rgb + (y + 1) * rowSize);
+        }
+
+        // Captures favour encoding speed over size, so the image data is stored in
+        // uncompressed deflate blocks.
+        static constexpr size_t MAX_BLOCK_SIZE = 65535;
+
+        std::vector<u8> zlib;
+        zlib.reserve(scanlines.size() + (scanlines.size() / MAX_BLOCK_SIZE + 1) * 5 + 6);
+        zlib.insert(zlib.end(), { 0x78, 0x01 });
+
+        u32 adlerA = 1, adlerB = 0;
+
+        for (size_t offset = 0; offset < scanlines.size() || offset == 0; offset += MAX_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(MAX_BLOCK_SIZE, scanlines.size() - offset);
+            bool isFinal = offset + blockSize >= scanlines.size();
+
+            u16 length = static_cast<u16>(blockSize);
+
+            zlib.push_back(isFinal ? 1 : 0);
+            zlib.push_back(length & 0xFF);
+            zlib.push_back(length >> 8);
+            zlib.push_back(~length & 0xFF);
+            zlib.push_back((~length >> 8) & 0xFF);
+
+            for (size_t i = offset; i < offset + blockSize; i++)
+            {
+                adlerA = (adlerA + scanlines[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+
+            zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+
+            if (isFinal) break;
+        }
+
+        writeU32(zlib, (adlerB << 16) | adlerA);
+
+        writeChunk("IDAT", zlib);
+        writeChunk("IEND", {});
+    }
+
+    void FrameCapture::WriteRaw(const char* path, const u8* texels, size_t size)
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file.is_open())
+        {
+            SNEK_LOG_ERROR("Failed to open " << path << " for writing");
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(texels), static_cast<std::streamsize>(size));
+    }
+
+    void FrameCapture::CompareGolden(const Job& job, const std::vector<u8>& rgb)
+    {
+        std::ifstream file(job.goldenPath, std::ios::binary);
+
+        std::string magic;
+        u32 width = 0, height = 0, maxValue = 0;
+
+        if (file.is_open()) file >> magic >> width >> height >> maxValue;
+
+        // A single whitespace character separates the header from the pixel data.
+        file.get();
+
+        bool isValid = file.good() && magic == "P6" && maxValue == 255 && width == job.width && height == job.height;
+
+        std::vector<u8> golden(rgb.size());
+        if (isValid) isValid = static_cast<bool>(file.read(reinterpret_cast<char*>(golden.data()), static_cast<std::streamsize>(golden.size())));
+
+        u32 mismatchedPixels = 0;
+        u32 maxDifference = 0;
+
+        if (isValid)
+        {
+            for (size_t i = 0; i < rgb.size(); i += 3)
+            {
+                u32 pixelDifference = 0;
+
+                for (size_t c = 0; c < 3; c++)
+                {
+                    u32 difference = static_cast<u32>(std::abs(static_cast<int>(rgb[i + c]) - static_cast<int>(golden[i + c])));
+                    pixelDifference = std::max(pixelDifference, difference);
+                }
+
+                if (pixelDifference > job.tolerance) mismatchedPixels++;
+                maxDifference = std::max(maxDifference, pixelDifference);
+            }
+        }
+        else
+        {
+            SNEK_LOG_WARNING("Golden image " << job.goldenPath << " is missing or doesn't match the captured frame's size");
+        }
+
+        bool passed = isValid && mismatchedPixels == 0;
+
+        if (!passed && isValid)
+        {
+            SNEK_LOG_WARNING(job.path << ": " << mismatchedPixels << " pixels differ from " << job.goldenPath
+                             << " (max difference: " << maxDifference << ")");
+        }
+
+        std::lock_guard<std::mutex> lock(jobMutex);
+
+        comparisonResult.comparedFrames++;
+        if (!passed) comparisonResult.failedFrames++;
+        comparisonResult.mismatchedPixels = mismatchedPixels;
+        comparisonResult.maxDifference = maxDifference;
+    }
+}
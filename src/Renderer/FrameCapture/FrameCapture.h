@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Buffer/Buffer.h"
+#include "../Swapchain/Swapchain.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace SnekVk
+{
+    /**
+     * @brief FrameCapture copies rendered images back to the CPU without stalling the render loop.
+     *
+     * When a capture is requested, the frame's color image is copied into a host-visible readback buffer
+     * owned by that frame in flight. The buffer is only read once the frame's fence has been waited on
+     * (which the renderer does anyway before re-using the frame), so the copy is consumed frames later
+     * rather than waited on. Encoding and writing to disk are done on a worker thread.
+     *
+     * Captured frames can optionally be compared against a golden image. Golden images must be binary
+     * PPM files with the same resolution as the captured frame.
+     */
+    class FrameCapture
+    {
+        public:
+
+        enum Format
+        {
+            PPM = 0,
+            PNG = 1,
+            // Unconverted texels, exactly as they were copied from the GPU.
+            RAW = 2
+        };
+
+        struct ComparisonResult
+        {
+            u32 comparedFrames = 0;
+            u32 failedFrames = 0;
+            // The number of pixels which differed by more than the tolerance in the last compared frame.
+            u32 mismatchedPixels = 0;
+            // The largest difference between any two channels in the last compared frame.
+            u32 maxDifference = 0;
+        };
+
+        /**
+         * @brief Starts the worker thread. Must be called before any frames are captured.
+         */
+        static void Initialise();
+
+        /**
+         * @brief Waits for all queued images to be written, stops the worker thread and releases all
+         * readback buffers. Must only be called once the device is idle.
+         */
+        static void Destroy();
+
+        /**
+         * @brief Captures the next frameCount frames. Each frame is written to '<pathPrefix>_<index>.<ext>',
+         * where index counts up from the first frame captured with this prefix.
+         *
+         * @param pathPrefix the path (without extension) that images are written to.
+         * @param frameCount the number of consecutive frames to capture.
+         * @param format the file format to write.
+         * @return false if the swapchain's images can't be read back, in which case nothing is captured.
+         */
+        static bool CaptureFrames(const char* pathPrefix, u32 frameCount = 1, Format format = PNG);
+
+        /**
+         * @brief Compares every captured frame against a golden image. Pass nullptr to stop comparing.
+         *
+         * @param goldenPath the path to a binary PPM file.
+         * @param tolerance the largest difference allowed between two channels before a pixel is considered
+         * mismatched.
+         */
+        static void CompareWithGolden(const char* goldenPath, u8 tolerance = 2);
+
+        /**
+         * @brief Returns the results of all golden image comparisons so far.
+         */
+        static ComparisonResult GetComparisonResult();
+
+        /**
+         * @brief Returns true if the current frame should be captured.
+         */
+        static bool IsCapturing() { return framesToCapture > 0; }
+
+        /**
+         * @brief Records a copy of a rendered image into the frame's readback buffer. Must be called
+         * after the render pass has ended. The image is returned to its original layout afterwards.
+         *
+         * @param commandBuffer the frame's command buffer.
+         * @param frameIndex the index of the frame in flight.
+         * @param image the image being captured.
+         * @param layout the layout that the image is currently in.
+         * @param extent the size of the image.
+         * @param format the format of the image. Must have four 8-bit channels.
+         */
+        static void RecordCopy(
+            VkCommandBuffer commandBuffer,
+            u32 frameIndex,
+            VkImage image,
+            VkImageLayout layout,
+            VkExtent2D extent,
+            VkFormat format
+        );
+
+        /**
+         * @brief Hands any completed readback for this frame to the worker thread. Must only be called once
+         * the frame's fence has been waited on.
+         *
+         * @param frameIndex the index of the frame in flight.
+         */
+        static void ProcessFrame(u32 frameIndex);
+
+        /**
+         * @brief Hands all completed readbacks to the worker thread. Must only be called once the device is idle.
+         */
+        static void ProcessAllFrames();
+
+        /**
+         * @brief Blocks until every queued image has been written.
+         */
+        static void WaitForWorker();
+
+        private:
+
+        struct ReadbackSlot
+        {
+            Buffer::Buffer buffer;
+            void* mappedData {nullptr};
+            VkExtent2D extent {0, 0};
+            VkFormat format {VK_FORMAT_UNDEFINED};
+            bool pending {false};
+            std::string path;
+            Format fileFormat {PNG};
+        };
+
+        struct Job
+        {
+            std::vector<u8> texels;
+            u32 width = 0;
+            u32 height = 0;
+            VkFormat format {VK_FORMAT_UNDEFINED};
+            std::string path;
+            Format fileFormat {PNG};
+            std::string goldenPath;
+            u8 tolerance = 0;
+        };
+
+        static void ResizeSlot(ReadbackSlot& slot, VkExtent2D extent);
+        static void SubmitSlot(ReadbackSlot& slot);
+
+        static void RunWorker();
+        static void ProcessJob(Job& job);
+
+        /**
+         * @brief Converts texels into tightly packed 8-bit RGB.
+         */
+        static std::vector<u8> ToRGB(const Job& job);
+
+        static void WritePPM(const char* path, const u8* rgb, u32 width, u32 height);
+        static void WritePNG(const char* path, const u8* rgb, u32 width, u32 height);
+        static void WriteRaw(const char* path, const u8* texels, size_t size);
+
+        static void CompareGolden(const Job& job, const std::vector<u8>& rgb);
+
+        static ReadbackSlot slots[SwapChain::MAX_FRAMES_IN_FLIGHT];
+
+        static u32 framesToCapture;
+        static u32 capturedFrames;
+        static std::string capturePrefix;
+        static Format captureFormat;
+
+        static std::string goldenPath;
+        static u8 goldenTolerance;
+        static ComparisonResult comparisonResult;
+
+        static std::deque<Job> jobs;
+        static std::thread worker;
+        static std::mutex jobMutex;
+        static std::condition_variable jobAdded;
+        static std::condition_variable jobsFinished;
+        static bool isProcessing;
+        static bool isRunning;
+    };
+}
@@ -50,6 +50,33 @@ namespace SnekVk {
         hasInfo = true;
     }
 
+    void FrameImages::InitOffscreenColorImage2D(u32 imageWidth, u32 imageHeight)
+    {
+        for (size_t i = 0; i < GetImageCount(); i++)
+        {
+            VkImageCreateInfo imageInfo = Image::CreateImageCreateInfo(VK_IMAGE_TYPE_2D,
+                                                                       imageFormat,
+                                                                       imageWidth,
+                                                                       imageHeight,
+                                                                       1, 1, 1,
+                                                                       VK_SAMPLE_COUNT_1_BIT,
+                                                                       VK_IMAGE_TILING_OPTIMAL,
+                                                                       VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT 
+                                                                            | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                                                       VK_SHARING_MODE_EXCLUSIVE);
+
+            device->CreateImageWithInfo(
+                    imageInfo,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    OUT images[i],
+                    OUT imageMemorys[i]);
+        }
+
+        InitColorImageView2D();
+
+        hasInfo = true;
+    }
+
     void FrameImages::InitColorImageView2D()
     {
         for (size_t i = 0; i < GetImageCount(); i++)
@@ -18,6 +18,15 @@ namespace SnekVk
         void InitColorImageView2D();
         void InitDepthImageView2D(u32 imageWidth, u32 imageHeight, u32 imageDepth);
 
+        /**
+         * @brief Creates color images (and their views) which are owned by this object rather than a swapchain.
+         * Used as render targets when rendering offscreen. The images can be copied from once rendered. 
+         * 
+         * @param imageWidth the width of each image.
+         * @param imageHeight the height of each image.
+         */
+        void InitOffscreenColorImage2D(u32 imageWidth, u32 imageHeight);
+
         void DestroyFrameImages();
 
         void SetFormat(VkFormat format) { imageFormat = format; }
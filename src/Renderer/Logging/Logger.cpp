@@ -0,0 +1,304 @@
+#include "Logger.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace SnekVk
+{
+    std::atomic<int> Logger::minimumLevel {Logger::LEVEL_INFO};
+
+    static const char* levelNames[] = { "[TRACE] ", "[INFO] ", "[WARNING] ", "[ERROR] " };
+
+    // Set once the writer has been destroyed during shutdown. Later messages are written synchronously.
+    static std::atomic<bool> isShutDown {false};
+
+    static void WriteMessage(Logger::Level level, const char* text, uint32_t length)
+    {
+        std::cout << levelNames[level];
+        std::cout.write(text, length);
+        std::cout << '\n';
+    }
+
+    /**
+     * A bounded multi-producer, single-consumer queue (based on Dmitry Vyukov's bounded MPMC queue). Each slot
+     * holds a sequence number which tells producers whether it's free and the writer whether it's been filled.
+     */
+    class LogWriter
+    {
+        public:
+
+        LogWriter()
+        {
+            for (uint64_t i = 0; i < Logger::RING_SIZE; i++) ring[i].sequence.store(i, std::memory_order_relaxed);
+
+            thread = std::thread(&LogWriter::Run, this);
+        }
+
+        ~LogWriter()
+        {
+            isStopping.store(true, std::memory_order_release);
+            wakeCondition.notify_one();
+
+            if (thread.joinable()) thread.join();
+
+            isShutDown.store(true, std::memory_order_release);
+        }
+
+        void Push(Logger::Level level, const char* text, uint32_t length)
+        {
+            uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+            uint32_t yieldCount = 0;
+            Slot* slot;
+
+            while (true)
+            {
+                slot = &ring[position & (Logger::RING_SIZE - 1)];
+
+                uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+                if (difference == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                }
+                else if (difference < 0)
+                {
+                    // The ring is full. Give the writer a few chances to run (it may share a core with us)
+                    // before dropping the message, so the caller never waits on the output itself.
+                    if (yieldCount++ == MAX_FULL_YIELDS)
+                    {
+                        droppedCount.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    Wake();
+                    std::this_thread::yield();
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+                else position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+
+            slot->level = level;
+            slot->length = length;
+            std::memcpy(slot->text, text, length);
+
+            slot->sequence.store(position + 1, std::memory_order_release);
+
+            // Wake the writer early once the ring starts filling up, rather than letting a burst overflow it
+            // while the writer sleeps.
+            if (position + 1 - writtenCount.load(std::memory_order_relaxed) >= HIGH_WATER_MARK) Wake();
+        }
+
+        void Flush()
+        {
+            uint64_t target = enqueuePosition.load(std::memory_order_acquire);
+
+            wakeCondition.notify_one();
+
+            while (writtenCount.load(std::memory_order_acquire) < target)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        private:
+
+        static constexpr uint64_t HIGH_WATER_MARK = Logger::RING_SIZE / 2;
+        static constexpr uint32_t MAX_FULL_YIELDS = 16;
+        static constexpr size_t MAX_BATCH_SIZE = 64 * 1024;
+
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence {0};
+            Logger::Level level = Logger::LEVEL_INFO;
+            uint32_t length = 0;
+            char text[Logger::MAX_MESSAGE_SIZE];
+        };
+
+        // Only the first producer to request a wake-up before the writer's next drain takes the lock.
+        void Wake()
+        {
+            if (isWakeRequested.exchange(true, std::memory_order_acq_rel)) return;
+
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+            }
+
+            wakeCondition.notify_one();
+        }
+
+        void Run()
+        {
+            while (true)
+            {
+                isWakeRequested.store(false, std::memory_order_release);
+
+                bool wroteMessages = Drain();
+
+                if (!wroteMessages)
+                {
+                    if (isStopping.load(std::memory_order_acquire)) break;
+
+                    std::unique_lock<std::mutex> lock(wakeMutex);
+                    wakeCondition.wait_for(lock, std::chrono::milliseconds(5), [this] {
+                        return isWakeRequested.load(std::memory_order_acquire) ||
+                               isStopping.load(std::memory_order_acquire);
+                    });
+                }
+            }
+        }
+
+        // Writes every message which has been published, then flushes the output once. Messages are copied
+        // into a batch so that their slots are handed back to producers without waiting on the output.
+        bool Drain()
+        {
+            bool wroteMessages = false;
+
+            while (true)
+            {
+                auto& slot = ring[dequeuePosition & (Logger::RING_SIZE - 1)];
+
+                if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) break;
+
+                batch.append(levelNames[slot.level]);
+                batch.append(slot.text, slot.length);
+                batch.push_back('\n');
+
+                slot.sequence.store(dequeuePosition + Logger::RING_SIZE, std::memory_order_release);
+                dequeuePosition++;
+                wroteMessages = true;
+
+                if (batch.size() >= MAX_BATCH_SIZE) WriteBatch();
+            }
+
+            WriteBatch();
+
+            uint64_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+
+            if (dropped > 0)
+            {
+                std::cout << levelNames[Logger::LEVEL_WARNING] << "Log buffer was full, dropped " << dropped
+                          << " messages\n";
+                wroteMessages = true;
+            }
+
+            if (wroteMessages) std::cout.flush();
+
+            writtenCount.store(dequeuePosition, std::memory_order_release);
+
+            return wroteMessages;
+        }
+
+        void WriteBatch()
+        {
+            std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            batch.clear();
+        }
+
+        Slot ring[Logger::RING_SIZE];
+
+        std::string batch;
+
+        std::atomic<uint64_t> enqueuePosition {0};
+        uint64_t dequeuePosition {0};
+
+        std::atomic<uint64_t> writtenCount {0};
+        std::atomic<uint64_t> droppedCount {0};
+
+        std::atomic<bool> isStopping {false};
+        // Set by the first producer past the high-water mark, and cleared by the writer before each drain.
+        std::atomic<bool> isWakeRequested {false};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+
+        std::thread thread;
+    };
+
+    // Created by the first message, and destroyed (after writing any remaining messages) on exit.
+    static LogWriter& GetWriter()
+    {
+        static LogWriter writer;
+        return writer;
+    }
+
+    void Logger::Push(Level level, const char* text, uint32_t length)
+    {
+        if (isShutDown.load(std::memory_order_acquire))
+        {
+            WriteMessage(level, text, length);
+            std::cout.flush();
+            return;
+        }
+
+        GetWriter().Push(level, text, length);
+    }
+
+    void Logger::Flush()
+    {
+        if (isShutDown.load(std::memory_order_acquire)) return;
+
+        GetWriter().Flush();
+    }
+
+    Logger::Message& Logger::Message::Append(const char* value, size_t count)
+    {
+        size_t available = MAX_MESSAGE_SIZE - length;
+        if (count > available) count = available;
+
+        std::memcpy(text + length, value, count);
+        length += static_cast<uint32_t>(count);
+
+        return *this;
+    }
+
+    Logger::Message& Logger::Message::operator<<(const char* value)
+    {
+        if (!value) return *this << "(null)";
+
+        return Append(value, std::strlen(value));
+    }
+
+    Logger::Message& Logger::Message::operator<<(double value)
+    {
+        char buffer[32];
+        int count = std::snprintf(buffer, sizeof(buffer), "%g", value);
+
+        return Append(buffer, count > 0 ? static_cast<size_t>(count) : 0);
+    }
+
+    Logger::Message& Logger::Message::operator<<(const void* value)
+    {
+        char buffer[32];
+        int count = std::snprintf(buffer, sizeof(buffer), "%p", value);
+
+        return Append(buffer, count > 0 ? static_cast<size_t>(count) : 0);
+    }
+
+    Logger::Message& Logger::Message::AppendSigned(int64_t value)
+    {
+        if (value >= 0) return AppendUnsigned(static_cast<uint64_t>(value));
+
+        Append("-", 1);
+
+        return AppendUnsigned(~static_cast<uint64_t>(value) + 1);
+    }
+
+    Logger::Message& Logger::Message::AppendUnsigned(uint64_t value)
+    {
+        char buffer[20];
+        size_t count = 0;
+
+        do
+        {
+            buffer[sizeof(buffer) - ++count] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+
+        return Append(buffer + sizeof(buffer) - count, count);
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#define SNEK_LOG_LEVEL_TRACE 0
+#define SNEK_LOG_LEVEL_INFO 1
+#define SNEK_LOG_LEVEL_WARNING 2
+#define SNEK_LOG_LEVEL_ERROR 3
+#define SNEK_LOG_LEVEL_NONE 4
+
+// Messages below this level are compiled out entirely. Can be overridden with -DSNEK_LOG_LEVEL=<level>.
+#ifndef SNEK_LOG_LEVEL
+#ifdef DEBUG
+#define SNEK_LOG_LEVEL SNEK_LOG_LEVEL_TRACE
+#else
+#define SNEK_LOG_LEVEL SNEK_LOG_LEVEL_INFO
+#endif
+#endif
+
+// Messages are streamed in the same way as assertion messages, i.e: SNEK_LOG_INFO("Extent: " << width).
+// Arguments are only evaluated if the level is enabled.
+#define SNEK_LOG(level, ...) \
+    do { \
+        if (SnekVk::Logger::IsEnabled(level)) \
+        { \
+            SnekVk::Logger::Message logMessage(level); \
+            logMessage << __VA_ARGS__; \
+        } \
+    } while (0)
+
+#if SNEK_LOG_LEVEL <= SNEK_LOG_LEVEL_TRACE
+#define SNEK_LOG_TRACE(...) SNEK_LOG(SnekVk::Logger::LEVEL_TRACE, __VA_ARGS__)
+#else
+#define SNEK_LOG_TRACE(...) do { } while (0)
+#endif
+
+#if SNEK_LOG_LEVEL <= SNEK_LOG_LEVEL_INFO
+#define SNEK_LOG_INFO(...) SNEK_LOG(SnekVk::Logger::LEVEL_INFO, __VA_ARGS__)
+#else
+#define SNEK_LOG_INFO(...) do { } while (0)
+#endif
+
+#if SNEK_LOG_LEVEL <= SNEK_LOG_LEVEL_WARNING
+#define SNEK_LOG_WARNING(...) SNEK_LOG(SnekVk::Logger::LEVEL_WARNING, __VA_ARGS__)
+#else
+#define SNEK_LOG_WARNING(...) do { } while (0)
+#endif
+
+#if SNEK_LOG_LEVEL <= SNEK_LOG_LEVEL_ERROR
+#define SNEK_LOG_ERROR(...) SNEK_LOG(SnekVk::Logger::LEVEL_ERROR, __VA_ARGS__)
+#else
+#define SNEK_LOG_ERROR(...) do { } while (0)
+#endif
+
+namespace SnekVk
+{
+    /**
+     * @brief The Logger writes leveled messages without blocking the calling thread. Messages are formatted
+     * into a fixed-size buffer on the caller's stack and pushed into a bounded, lock-free ring buffer, which
+     * a background thread drains to stdout.
+     *
+     * Any thread can log. The writer is woken early once the ring is half full. If the ring is still full
+     * after yielding to the writer a few times, the message is dropped rather than waiting for space, and
+     * the number of dropped messages is reported once the writer catches up. Messages longer than
+     * MAX_MESSAGE_SIZE are truncated.
+     */
+    class Logger
+    {
+        public:
+
+        enum Level
+        {
+            LEVEL_TRACE = SNEK_LOG_LEVEL_TRACE,
+            LEVEL_INFO = SNEK_LOG_LEVEL_INFO,
+            LEVEL_WARNING = SNEK_LOG_LEVEL_WARNING,
+            LEVEL_ERROR = SNEK_LOG_LEVEL_ERROR
+        };
+
+        // Must be a power of two.
+        static constexpr uint32_t RING_SIZE = 2048;
+        static constexpr uint32_t MAX_MESSAGE_SIZE = 256;
+
+        /**
+         * @brief Formats a single message, which is queued once the message goes out of scope.
+         */
+        class Message
+        {
+            public:
+
+            Message(Level level) : level{level} {}
+            ~Message() { Push(level, text, length); }
+
+            Message(const Message&) = delete;
+            Message& operator=(const Message&) = delete;
+
+            Message& operator<<(const char* value);
+            Message& operator<<(const std::string& value) { return Append(value.data(), value.size()); }
+            Message& operator<<(char value) { return Append(&value, 1); }
+            Message& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+            Message& operator<<(double value);
+            Message& operator<<(const void* value);
+
+            template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+            Message& operator<<(T value)
+            {
+                if (std::is_signed<T>::value) return AppendSigned(static_cast<int64_t>(value));
+                return AppendUnsigned(static_cast<uint64_t>(value));
+            }
+
+            template<typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+            Message& operator<<(T value)
+            {
+                return *this << static_cast<typename std::underlying_type<T>::type>(value);
+            }
+
+            private:
+
+            Message& Append(const char* value, size_t count);
+            Message& AppendSigned(int64_t value);
+            Message& AppendUnsigned(uint64_t value);
+
+            Level level;
+            char text[MAX_MESSAGE_SIZE];
+            uint32_t length {0};
+        };
+
+        /**
+         * @brief Sets the lowest level which is written, LEVEL_INFO by default. Levels compiled out by
+         * SNEK_LOG_LEVEL can't be re-enabled at runtime.
+         */
+        static void SetLevel(Level level) { minimumLevel.store(level, std::memory_order_relaxed); }
+
+        static bool IsEnabled(Level level) { return level >= minimumLevel.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Blocks until every message queued so far has been written.
+         */
+        static void Flush();
+
+        private:
+
+        static void Push(Level level, const char* text, uint32_t length);
+
+        static std::atomic<int> minimumLevel;
+    };
+}
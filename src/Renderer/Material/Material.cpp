@@ -2,6 +2,10 @@
 #include "../Mesh/Mesh.h"
 #include "../Swapchain/Swapchain.h"
 #include "../Utils/Descriptor.h"
+#include "../DeletionQueue/DeletionQueue.h"
+#include "../Pipeline/PipelineRegistry.h"
+#include "../Profiling/CpuProfiler.h"
+#include "../Profiling/RenderStatistics.h"
 
 namespace SnekVk
 {
@@ -69,59 +73,132 @@ namespace SnekVk
             layoutCount, 
             pushConstants, 
             pushConstantCount);
+
+        // Pipelines compiled with this layout may be shared with other materials, so the registry
+        // destroys it once neither this material nor those pipelines need it.
+        PipelineRegistry::RetainLayout(pipelineLayout);
     }
 
     void Material::Bind(VkCommandBuffer commandBuffer)
     {
+        SNEK_ASSERT(pipelineLayout != VK_NULL_HANDLE, "Cannot bind a material which hasn't been built!");
+        SNEK_ASSERT(isBuilt.load(std::memory_order_acquire),
+            "Cannot bind a material while its pipeline is being compiled! Wait on BuildMaterialAsync's future first.");
+
         pipeline.Bind(commandBuffer);
 
         vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSets.Count(), descriptorSets.Data(), descriptorOffsets.Count(), descriptorOffsets.Data());
+
+        RenderStatistics::Increment(RenderStatistics::PIPELINE_BINDS);
+        RenderStatistics::Increment(RenderStatistics::DESCRIPTOR_SET_BINDS, descriptorSets.Count());
+
+        // Default to the material's own parameters.
+        if (IsInstanced()) BindInstance(commandBuffer, 0);
     }
 
-    void Material::RecreatePipeline()
+    void Material::SetInstanceParameters(const char* name, u64 parameterSize)
     {
-        // Clear our graphics pipeline before swapchain re-creation
-        pipeline.ClearPipeline();
+        SNEK_ASSERT(pipelineLayout == VK_NULL_HANDLE, "Instance parameters must be set before the material is built!");
 
-        CreatePipeline();
+        instanceParametersId = INTERN_STR(name);
+        instanceParameterSize = parameterSize;
     }
 
-    void Material::CreatePipeline()
+    u32 Material::AcquireInstanceSlot()
     {
-        Utils::StackArray<PipelineConfig::ShaderConfig, MAX_SHADERS> shaderConfigs;
+        SNEK_ASSERT(IsInstanced(), "Cannot create an instance of a material without instance parameters!");
 
-        if (vertexShader) shaderConfigs.Append({ vertexShader->GetPath(), vertexShader->GetStage() });
-        if (fragmentShader) shaderConfigs.Append({ fragmentShader->GetPath(), fragmentShader->GetStage() });
+        if (!freeInstanceSlots.empty())
+        {
+            u32 slot = freeInstanceSlots.back();
+            freeInstanceSlots.pop_back();
+            isInstanceSlotUsed[slot] = 1;
+            return slot;
+        }
 
-        size_t bindingCount = propertiesArray.Count();
+        SNEK_ASSERT(instanceSlotCount < instanceCapacity, 
+            "Maximum number of material instances has been reached. Maximum is " << instanceCapacity);
 
-        VkDescriptorSetLayout layouts[bindingCount];
+        isInstanceSlotUsed[instanceSlotCount] = 1;
 
-        for(size_t i = 0; i < bindingCount; i++)
-        {
-            layouts[i] = propertiesArray.Get(i).descriptorBinding.layout;
-        }
+        return instanceSlotCount++;
+    }
 
-        CreateLayout(layouts, bindingCount);
+    void Material::ReleaseInstanceSlot(u32 slot)
+    {
+        if (slot == 0) return;
+
+        // Releasing a slot twice would hand it to two instances.
+        SNEK_ASSERT(slot < instanceSlotCount && isInstanceSlotUsed[slot], 
+            "Instance slot " << slot << " is not in use!");
+
+        isInstanceSlotUsed[slot] = 0;
+        freeInstanceSlots.push_back(slot);
+    }
+
+    void Material::SetInstanceData(u32 slot, VkDeviceSize dataSize, const void* data)
+    {
+        SNEK_ASSERT(dataSize <= instanceParameterSize, "Instance data is larger than the material's instance parameters!");
+
+        auto& property = GetProperty(instanceParametersId);
+
+        Buffer::CopyData(buffer, dataSize, data, property.offset + (slot * instanceParameterSize));
+    }
+
+    void Material::BindInstance(VkCommandBuffer commandBuffer, u32 slot)
+    {
+        vkCmdPushConstants(
+            commandBuffer, 
+            pipelineLayout, 
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+            0, 
+            sizeof(u32), 
+            &slot
+        );
+    }
+
+    void Material::RecreatePipeline()
+    {
+        // The pipeline keeps its shader modules, so no shaders need to be re-loaded. If the 
+        // new render pass is compatible with the old one then the existing pipeline is kept.
+        auto pipelineConfig = Pipeline::DefaultPipelineConfig();
+        ConfigurePipeline(pipelineConfig);
+
+        pipeline.RecreatePipeline(pipelineConfig);
+    }
+
+    void Material::CreatePipeline()
+    {
+        CPU_PROFILE_SCOPE("Material::CreatePipeline");
 
         SNEK_ASSERT(pipelineLayout != nullptr, "Cannot create pipeline without a valid layout!");
-        
-        // TODO(Aryeh): Maybe pipelineConfig should be a builder class?
 
         auto pipelineConfig = Pipeline::DefaultPipelineConfig();
-        pipelineConfig.rasterizationInfo.polygonMode = (VkPolygonMode)shaderSettings.mode;
-        pipelineConfig.inputAssemblyInfo.topology = (VkPrimitiveTopology)shaderSettings.topology;
-        
-        pipelineConfig.renderPass = SwapChain::GetInstance()->GetRenderPass()->GetRenderPass();
-        pipelineConfig.pipelineLayout = pipelineLayout;
-        
-        pipelineConfig.vertexData = VertexDescription::CreateDescriptions(vertexCount, vertexBindings.Data());
+        ConfigurePipeline(pipelineConfig);
 
         pipeline.RecreatePipeline(
             shaderConfigs.Data(),
             shaderCount,
             pipelineConfig
         );
+
+        isBuilt.store(true, std::memory_order_release);
+    }
+
+    void Material::ConfigurePipeline(PipelineConfigInfo& pipelineConfig)
+    {
+        // TODO(Aryeh): Maybe pipelineConfig should be a builder class?
+        pipelineConfig.rasterizationInfo.polygonMode = (VkPolygonMode)shaderSettings.mode;
+        pipelineConfig.inputAssemblyInfo.topology = (VkPrimitiveTopology)shaderSettings.topology;
+        
+        auto renderPass = SwapChain::GetInstance()->GetRenderPass();
+
+        pipelineConfig.renderPass = renderPass->GetRenderPass();
+        pipelineConfig.renderPassKey = renderPass->GetCompatibilityKey();
+        pipelineConfig.pipelineLayout = pipelineLayout;
+        pipelineConfig.layoutKey = layoutKey;
+        
+        pipelineConfig.vertexData = vertexData;
     }
 
     // NOTE(Aryeh): At some point it might be useful to batch create
@@ -147,7 +224,7 @@ namespace SnekVk
         VkWriteDescriptorSet writeDescriptorSets[propertiesCount];
         VkDescriptorBufferInfo bufferInfos[propertiesCount];
 
-        std::cout << "Allocating descriptor set storage of " << propertiesCount << std::endl;
+        SNEK_LOG_TRACE("Allocating descriptor set storage of " << propertiesCount);
 
         for (size_t i = 0; i < propertiesCount; i++)
         {
@@ -166,7 +243,7 @@ namespace SnekVk
             auto stage = property.stage == VK_SHADER_STAGE_VERTEX_BIT ? "vertex" : 
                 property.stage == VK_SHADER_STAGE_FRAGMENT_BIT ? "fragment" : "unknown";
 
-            std::cout << "Creating a layout binding for binding " << property.binding << " at stage: " << stage << std::endl;
+            SNEK_LOG_TRACE("Creating a layout binding for binding " << property.binding << " at stage: " << stage);
 
             // Create all layouts
             
@@ -176,9 +253,9 @@ namespace SnekVk
             u64 offset = property.offset;
 
             bufferInfos[i] = Utils::Descriptor::CreateBufferInfo(buffer.buffer, offset, property.size * property.count);
-            std::cout << "Property Size: " << property.size * property.count << std::endl;
+            SNEK_LOG_TRACE("Property Size: " << property.size * property.count);
 
-            std::cout << "Allocating descriptor set for binding " << property.binding << std::endl;
+            SNEK_LOG_TRACE("Allocating descriptor set for binding " << property.binding);
             Utils::Descriptor::AllocateSets(device->Device(), &binding.descriptorSet, descriptorPool, 1, &binding.layout);
 
             descriptorSets.Append(binding.descriptorSet);
@@ -192,9 +269,9 @@ namespace SnekVk
             );
         }
 
-        std::cout << "Successfully created all required layouts!" << std::endl;
+        SNEK_LOG_TRACE("Successfully created all required layouts!");
 
-        std::cout << "Total descriptor sets: " <<  descriptorSets.Count() << std::endl;
+        SNEK_LOG_TRACE("Total descriptor sets: " <<  descriptorSets.Count());
 
         Utils::Descriptor::WriteSets(device->Device(), writeDescriptorSets, propertiesCount);
     }
@@ -231,7 +308,7 @@ namespace SnekVk
         {
             if (HasProperty(uniform.id))
             {
-                std::cout << "Property already exists!" << std::endl;
+                SNEK_LOG_TRACE("Property already exists!");
                 auto& property = GetProperty(uniform.id);
                 property.stage = property.stage | (VkShaderStageFlags) shader->GetStage();
                 continue;
@@ -247,11 +324,11 @@ namespace SnekVk
             };
 
             property.descriptorBinding = { VK_NULL_HANDLE, VK_NULL_HANDLE, (Shader::DescriptorType)uniform.type };
-            propertiesArray.Append(property);
+            AddProperty(property);
 
-            std::cout << "Added new uniform to binding: " << uniform.binding << std::endl;
+            SNEK_LOG_TRACE("Added new uniform to binding: " << uniform.binding);
 
-            std::cout << "Added new property of size: " << uniform.size << " with buffer offset: " << offset << std::endl;
+            SNEK_LOG_TRACE("Added new property of size: " << uniform.size << " with buffer offset: " << offset);
 
             offset += (uniform.size * uniform.arraySize) * uniform.dynamicCount;
         }
@@ -259,16 +336,29 @@ namespace SnekVk
     
     void Material::DestroyMaterial()
     {
-        auto device = VulkanDevice::GetDeviceInstance();
+        VkDescriptorSetLayout layouts[MAX_MATERIAL_BINDINGS] {VK_NULL_HANDLE};
+        size_t layoutCount = propertiesArray.Count();
 
-        for (auto& property : propertiesArray)
+        for (size_t i = 0; i < layoutCount; i++)
         {
-            vkDestroyDescriptorSetLayout(device->Device(), property.descriptorBinding.layout, nullptr);
+            layouts[i] = propertiesArray.Get(i).descriptorBinding.layout;
         }
 
+        // Frames in flight may still be bound to this material.
+        DeletionQueue::Enqueue([layouts, layoutCount]() {
+            auto device = VulkanDevice::GetDeviceInstance();
+
+            for (size_t i = 0; i < layoutCount; i++)
+            {
+                vkDestroyDescriptorSetLayout(device->Device(), layouts[i], nullptr);
+            }
+        });
+
+        isBuilt.store(false, std::memory_order_relaxed);
         pipeline.DestroyPipeline();
-        
-        vkDestroyPipelineLayout(device->Device(), pipelineLayout, nullptr);
+
+        PipelineRegistry::ReleaseLayout(pipelineLayout);
+        pipelineLayout = VK_NULL_HANDLE;
         
         Buffer::DestroyBuffer(buffer);
 
@@ -282,56 +372,80 @@ namespace SnekVk
 
     void Material::SetUniformData(Utils::StringId id, VkDeviceSize dataSize, const void* data)
     {
-        for(auto& property : propertiesArray)
-        {
-            if (id == property.id) {
-
-                Buffer::CopyData(buffer, dataSize, data, property.offset);
-                return;
-            }
-        }
+        if (auto property = FindProperty(id)) Buffer::CopyData(buffer, dataSize, data, property->offset);
     }
 
     bool Material::HasProperty(Utils::StringId id)
     {
-        for(auto& property : propertiesArray)
-        {
-            if (id == property.id) {
-                return true;
-            }
-        }
-        return false;
+        return FindProperty(id) != nullptr;
     }
 
     void Material::SetUniformData(const char* name, VkDeviceSize dataSize, const void* data)
     {
-        auto id = INTERN_STR(name);
+        SetUniformData(Utils::WSID(name), dataSize, data);
+    }
+
+    void Material::BuildMaterials(std::initializer_list<Material*> materials)
+    {
+        // Descriptor allocation and buffer creation aren't thread-safe, so these are done upfront.
+        for (auto material : materials) material->SetupMaterial();
+
+        Utils::Array<std::future<void>> pipelineJobs(materials.size());
 
-        for(auto& property : propertiesArray)
+        size_t jobIndex = 0;
+        for (auto material : materials) 
         {
-            if (id == property.id) {
-                Buffer::CopyData(buffer, dataSize, data, property.offset);
-                return;
-            }
+            pipelineJobs[jobIndex++] = std::async(std::launch::async, &Material::CreatePipeline, material);
         }
+
+        for (auto& job : pipelineJobs) job.get();
+
+        SNEK_LOG_INFO("Built " << materials.size() << " materials");
     }
 
-    void Material::BuildMaterials(std::initializer_list<Material*> materials)
+    Material::Property* Material::FindProperty(Utils::StringId id)
     {
-        for (auto material : materials) material->BuildMaterial();
+        size_t slot = id & (PROPERTY_TABLE_SIZE - 1);
+
+        while (propertyTable[slot].id != 0)
+        {
+            if (propertyTable[slot].id == id) return &propertiesArray[propertyTable[slot].index];
+
+            slot = (slot + 1) & (PROPERTY_TABLE_SIZE - 1);
+        }
+
+        return nullptr;
     }
 
     Material::Property& Material::GetProperty(Utils::StringId id)
     {
-        for(auto& property : propertiesArray)
+        auto property = FindProperty(id);
+
+        if (!property)
         {
-            if (id == property.id) return property;
+            const char* name = Utils::LookupStringId(id);
+
+            SNEK_ASSERT(false, "No property with ID: " << id << " (" << (name ? name : "unknown") << ") exists!");
         }
 
-        SNEK_ASSERT(false, "No property with ID: " << id << " exists!");
+        return *property;
     }
 
-    void Material::BuildMaterial()
+    void Material::AddProperty(const Property& property)
+    {
+        SNEK_ASSERT(property.id != 0, "Property IDs must be non-zero!");
+
+        u32 index = static_cast<u32>(propertiesArray.Count());
+        propertiesArray.Append(property);
+
+        size_t slot = property.id & (PROPERTY_TABLE_SIZE - 1);
+
+        while (propertyTable[slot].id != 0) slot = (slot + 1) & (PROPERTY_TABLE_SIZE - 1);
+
+        propertyTable[slot] = {property.id, index};
+    }
+
+    void Material::SetupMaterial()
     {
         // Allocate buffer which can store all the data we need
         Buffer::CreateBuffer(
@@ -348,20 +462,84 @@ namespace SnekVk
         {
             AddShader(vertexShader);
             SetShaderProperties(vertexShader, OUT offset);
+            shaderConfigs.Append({ vertexShader->GetPath(), vertexShader->GetStage() });
         }
 
         if (fragmentShader)
         {
             AddShader(fragmentShader);
             SetShaderProperties(fragmentShader, OUT offset);
+            shaderConfigs.Append({ fragmentShader->GetPath(), fragmentShader->GetStage() });
         }
         
-        std::cout << "Total properties: " << propertiesArray.Count() << std::endl;
+        SNEK_LOG_TRACE("Total properties: " << propertiesArray.Count());
 
         CreateDescriptors();
 
+        size_t bindingCount = propertiesArray.Count();
+
+        VkDescriptorSetLayout layouts[bindingCount];
+
+        for(size_t i = 0; i < bindingCount; i++)
+        {
+            layouts[i] = propertiesArray.Get(i).descriptorBinding.layout;
+        }
+
+        // Each property is given its own descriptor set with a single binding.
+        layoutKey.clear();
+        Utils::AppendKey(layoutKey, bindingCount);
+
+        for (auto& property : propertiesArray)
+        {
+            Utils::AppendKey(layoutKey, property.binding, property.descriptorBinding.type, property.stage);
+        }
+
+        if (IsInstanced())
+        {
+            auto& property = GetProperty(instanceParametersId);
+
+            instanceCapacity = static_cast<u32>(property.size / instanceParameterSize);
+            isInstanceSlotUsed.assign(instanceCapacity, 0);
+
+            // Slot 0 is drawn by default, so it starts with every parameter set to 1. This makes tints 
+            // white and opaque until the material's own parameters are set.
+            std::vector<float> defaultParameters(instanceParameterSize / sizeof(float), 1.f);
+            SetInstanceData(0, defaultParameters.size() * sizeof(float), defaultParameters.data());
+
+            // Instanced materials receive the index of their instance's parameters per draw.
+            auto instanceIndex = PipelineConfig::CreatePushConstantRange(
+                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+                0, 
+                sizeof(u32)
+            );
+
+            CreateLayout(layouts, bindingCount, &instanceIndex, 1);
+
+            Utils::AppendKey(layoutKey, instanceIndex.stageFlags, instanceIndex.size);
+        }
+        else 
+        {
+            CreateLayout(layouts, bindingCount);
+        }
+
+        // Vertex bindings reference attributes stored in our shaders. Since shaders aren't guaranteed 
+        // to outlive the material we copy the descriptions here for any future pipeline re-creation.
+        vertexData = VertexDescription::CreateDescriptions(vertexCount, vertexBindings.Data());
+
+        SNEK_LOG_TRACE("Built material with size: " << bufferSize);
+    }
+
+    void Material::BuildMaterial()
+    {
+        CPU_PROFILE_SCOPE("Material::BuildMaterial");
+
+        SetupMaterial();
         CreatePipeline();
+    }
 
-        std::cout << "Built material with size: " << bufferSize << std::endl;
+    std::future<void> Material::BuildMaterialAsync()
+    {
+        SetupMaterial();
+        return std::async(std::launch::async, &Material::CreatePipeline, this);
     }
-}
+}
\ No newline at end of file
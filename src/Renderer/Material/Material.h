@@ -6,6 +6,10 @@
 #include "../Shader/Shader.h"
 #include "../DescriptorPool/DescriptorPool.h"
 
+#include <atomic>
+#include <future>
+#include <vector>
+
 namespace SnekVk
 {
     class Material
@@ -45,6 +49,16 @@ namespace SnekVk
         void SetTopology(Topology topology) { shaderSettings.topology = topology; }
         void BuildMaterial();
 
+        /**
+         * @brief Builds the material's resources on the calling thread and compiles its pipeline
+         * on a worker thread. Useful for materials which aren't needed on the first frame. The
+         * returned future must be waited on (with get() or wait()) before the material is bound,
+         * since the worker is still writing the pipeline until then. Bind() asserts this.
+         *
+         * @return std::future<void> a future which completes once the pipeline has been compiled.
+         */
+        std::future<void> BuildMaterialAsync();
+
         void SetUniformData(VkDeviceSize dataSize, const void* data);
         void SetUniformData(Utils::StringId id, VkDeviceSize dataSize, const void* data);
         void SetUniformData(const char* name, VkDeviceSize dataSize, const void* data);
@@ -54,12 +68,42 @@ namespace SnekVk
 
         bool HasProperty(Utils::StringId id);
 
+        /**
+         * @brief Marks a storage property as holding per-instance parameters. Each MaterialInstance
+         * is given a slot in this property, and the slot being drawn is passed to the shaders through
+         * a push constant. Slot 0 holds the material's own parameters, which start with every float
+         * set to 1 (a white, opaque tint). Must be called before the material is built.
+         * 
+         * @param name the name of the storage property holding instance parameters.
+         * @param parameterSize the size of a single instance's parameters.
+         */
+        void SetInstanceParameters(const char* name, u64 parameterSize);
+
+        bool IsInstanced() { return instanceParametersId != 0; }
+
+        u32 AcquireInstanceSlot();
+        void ReleaseInstanceSlot(u32 slot);
+
+        void SetInstanceData(u32 slot, VkDeviceSize dataSize, const void* data);
+
+        /**
+         * @brief Selects which instance's parameters are used by subsequent draws. Does not 
+         * re-bind the pipeline or any descriptor sets.
+         */
+        void BindInstance(VkCommandBuffer commandBuffer, u32 slot);
+
         void Bind(VkCommandBuffer commandBuffer);
         void CreatePipeline();
         void RecreatePipeline();
 
         void DestroyMaterial();
 
+        /**
+         * @brief Builds a group of materials. Material resources are created serially, after which all
+         * pipelines are compiled concurrently on worker threads. Returns once every pipeline is ready.
+         * 
+         * @param materials the materials being built.
+         */
         static void BuildMaterials(std::initializer_list<Material*> materials);
 
         private:
@@ -81,11 +125,31 @@ namespace SnekVk
             DescriptorBinding descriptorBinding;
         };
 
+        // Maps property IDs to their index in the properties array. Open addressing with linear probing,
+        // kept at most half full so lookups are usually a single compare. An ID of 0 marks an empty slot.
+        static constexpr size_t PROPERTY_TABLE_SIZE = 32;
+
+        static_assert((PROPERTY_TABLE_SIZE & (PROPERTY_TABLE_SIZE - 1)) == 0, "Property table size must be a power of two");
+        static_assert(PROPERTY_TABLE_SIZE >= MAX_MATERIAL_BINDINGS * 2, "Property table is too small");
+
+        struct PropertySlot
+        {
+            Utils::StringId id = 0;
+            u32 index = 0;
+        };
+
         Material(Shader* vertexShader, Shader* fragmentShader, u32 shaderCount);
 
+        Property* FindProperty(Utils::StringId id);
         Property& GetProperty(Utils::StringId id);
+        void AddProperty(const Property& property);
         void AddShader(Shader* shader);
         void SetShaderProperties(Shader* shader, u64& offset);
+        void ConfigurePipeline(PipelineConfigInfo& pipelineConfig);
+
+        // Creates the material's buffer, descriptors and pipeline layout. Everything 
+        // which isn't thread-safe must happen here rather than in CreatePipeline().
+        void SetupMaterial();
 
         void CreateLayout(
             VkDescriptorSetLayout* layouts = nullptr, 
@@ -105,7 +169,12 @@ namespace SnekVk
         Shader* vertexShader {nullptr};
         Shader* fragmentShader {nullptr};
 
+        // Shader data is copied during setup so pipelines can be compiled after the 
+        // shaders themselves have gone out of scope.
+        Utils::StackArray<PipelineConfig::ShaderConfig, MAX_SHADERS> shaderConfigs;
+
         Utils::StackArray<Property, MAX_MATERIAL_BINDINGS> propertiesArray;
+        PropertySlot propertyTable[PROPERTY_TABLE_SIZE];
 
         Buffer::Buffer buffer;
         u64 bufferSize = 0;
@@ -114,10 +183,27 @@ namespace SnekVk
         Utils::StackArray<u32, MAX_MATERIAL_BINDINGS> descriptorOffsets;
 
         Utils::StackArray<VertexDescription::Binding, MAX_MATERIAL_BINDINGS> vertexBindings;
+        VertexDescription::Data vertexData;
         
         Pipeline pipeline;
         VkPipelineLayout pipelineLayout {VK_NULL_HANDLE};
 
+        // Set once the pipeline has been compiled, which may happen on a worker thread.
+        std::atomic<bool> isBuilt {false};
+
+        // Describes the descriptor set layouts used by this material. Materials with matching 
+        // layout descriptions can share pipelines. 
+        std::string layoutKey;
+
+        // Instance parameters
+        
+        Utils::StringId instanceParametersId = 0;
+        u64 instanceParameterSize = 0;
+        u32 instanceCapacity = 0;
+        u32 instanceSlotCount = 1;
+        std::vector<u32> freeInstanceSlots;
+        std::vector<u8> isInstanceSlotUsed;
+
         bool isFreed = false;
     };
 }
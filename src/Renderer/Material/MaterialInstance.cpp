@@ -0,0 +1,46 @@
+#include "MaterialInstance.h"
+
+namespace SnekVk
+{
+    MaterialInstance::MaterialInstance() {}
+
+    MaterialInstance::MaterialInstance(Material* parent)
+    {
+        SetParent(parent);
+    }
+
+    MaterialInstance::~MaterialInstance()
+    {
+        DestroyInstance();
+    }
+
+    void MaterialInstance::SetParent(Material* newParent)
+    {
+        DestroyInstance();
+
+        SNEK_ASSERT(newParent != nullptr, "A material instance requires a valid parent material!");
+
+        parent = newParent;
+        slot = parent->AcquireInstanceSlot();
+    }
+
+    void MaterialInstance::SetParameters(VkDeviceSize dataSize, const void* data)
+    {
+        parent->SetInstanceData(slot, dataSize, data);
+    }
+
+    void MaterialInstance::Bind(VkCommandBuffer commandBuffer)
+    {
+        parent->BindInstance(commandBuffer, slot);
+    }
+
+    void MaterialInstance::DestroyInstance()
+    {
+        if (parent == nullptr) return;
+
+        parent->ReleaseInstanceSlot(slot);
+
+        parent = nullptr;
+        slot = 0;
+    }
+}
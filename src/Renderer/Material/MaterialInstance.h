@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Core.h"
+#include "Material.h"
+
+namespace SnekVk
+{
+    /**
+     * @brief A MaterialInstance is a lightweight variation of a Material. Instances share their parent's
+     * pipeline, layout and descriptor sets, and only own a slot in the parent's instance parameter buffer.
+     * Drawing with a different instance of the same material never changes the bound pipeline, it only 
+     * changes the parameter index pushed to the shaders.
+     *
+     * The parent material must have instance parameters set (see Material::SetInstanceParameters) and must
+     * outlive all of its instances.
+     */
+    class MaterialInstance
+    {
+        public:
+
+        MaterialInstance();
+        MaterialInstance(Material* parent);
+        ~MaterialInstance();
+
+        MaterialInstance(const MaterialInstance&) = delete;
+        MaterialInstance& operator=(const MaterialInstance&) = delete;
+
+        /**
+         * @brief Assigns the instance to a material, releasing any slot held in a previous parent.
+         * 
+         * @param parent the material being instanced.
+         */
+        void SetParent(Material* parent);
+
+        /**
+         * @brief Writes this instance's parameters into its slot in the parent's parameter buffer. 
+         * 
+         * @param dataSize the size of the parameter data.
+         * @param data a pointer to the parameter data.
+         */
+        void SetParameters(VkDeviceSize dataSize, const void* data);
+
+        /**
+         * @brief Selects this instance for all subsequent draws. Assumes the parent material is already bound.
+         * 
+         * @param commandBuffer the command buffer being recorded to.
+         */
+        void Bind(VkCommandBuffer commandBuffer);
+
+        Material* GetParent() { return parent; }
+        u32 GetSlot() { return slot; }
+
+        void DestroyInstance();
+
+        private:
+
+        Material* parent {nullptr};
+        u32 slot = 0;
+    };
+}
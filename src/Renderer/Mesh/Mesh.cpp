@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include "../Profiling/RenderStatistics.h"
 
 namespace SnekVk
 {
@@ -23,70 +24,59 @@ namespace SnekVk
     Mesh::~Mesh()
     {
         if (isFreed) return;
-        std::cout << "Destroying Mesh" << std::endl;
+        SNEK_LOG_TRACE("Destroying Mesh");
         DestroyMesh();
     }
 
+    // Dynamic meshes are updated every frame, so buffers grow geometrically to avoid re-creating them
+    // each time a few more vertices are added.
+    static VkDeviceSize GrowCapacity(VkDeviceSize capacity, VkDeviceSize required)
+    {
+        return required > capacity * 2 ? required : capacity * 2;
+    }
+
     void Mesh::LoadVertices(const Mesh::MeshData& meshData)
     {
         vertexCount = meshData.vertexCount;
         indexCount = meshData.indexCount;
         vertexSize = meshData.vertexSize;
 
-        VkDeviceSize bufferSize = vertexSize * MAX_VERTICES;
-
-        Buffer::CreateBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            // specifies that data is accessible on the CPU.
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
-            // Ensures that CPU and GPU memory are consistent across both devices.
-            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            OUT globalStagingBuffer.buffer,
-            OUT globalStagingBuffer.bufferMemory);
-
-        // TODO(Aryeh): Only create this if there actually are indices
-        Buffer::CreateBuffer(
-            indexSize * MAX_INDICES,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            // specifies that data is accessible on the CPU.
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
-            // Ensures that CPU and GPU memory are consistent across both devices.
-            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            OUT globalIndexStagingBuffer.buffer,
-            OUT globalIndexStagingBuffer.bufferMemory);
-
         hasVertexBuffer = vertexCount > 0;
 
-        if (hasVertexBuffer) CreateVertexBuffers(meshData.vertices);
+        if (hasVertexBuffer) CreateVertexBuffers(meshData.vertices, vertexSize * vertexCount);
 
         hasIndexBuffer = indexCount > 0;
 
-        if (hasIndexBuffer) CreateIndexBuffer(meshData.indices);
+        if (hasIndexBuffer) CreateIndexBuffer(meshData.indices, indexSize * indexCount);
     }
 
     void Mesh::DestroyMesh()
     {
-        Buffer::DestroyBuffer(vertexBuffer);
-        Buffer::DestroyBuffer(globalStagingBuffer);
-        Buffer::DestroyBuffer(globalIndexStagingBuffer);
+        if (hasVertexBuffer) DestroyVertexBuffers();
 
-        if (hasIndexBuffer) 
-        {
-            Buffer::DestroyBuffer(indexBuffer);
-        }
+        if (hasIndexBuffer) DestroyIndexBuffers();
         
         isFreed = true;
     }
 
-    void Mesh::CreateVertexBuffers(const void* vertices)
+    void Mesh::CreateVertexBuffers(const void* vertices, VkDeviceSize capacity)
     {
-        VkDeviceSize bufferSize = vertexSize * MAX_VERTICES;
+        VkDeviceSize dataSize = vertexSize * vertexCount;
 
-        Buffer::CopyData(globalStagingBuffer, vertexSize * vertexCount, vertices);
+        Buffer::CreateBuffer(
+            capacity,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            // specifies that data is accessible on the CPU.
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
+            // Ensures that CPU and GPU memory are consistent across both devices.
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            OUT globalStagingBuffer.buffer,
+            OUT globalStagingBuffer.bufferMemory);
+
+        Buffer::CopyData(globalStagingBuffer, dataSize, vertices);
 
         Buffer::CreateBuffer(
-            bufferSize,
+            capacity,
             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             // specifies that data is accessible on the CPU.
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -94,25 +84,56 @@ namespace SnekVk
             OUT vertexBuffer.bufferMemory
         );
 
-        Buffer::CopyBuffer(globalStagingBuffer.buffer, vertexBuffer.buffer, bufferSize);
+        Buffer::CopyBuffer(globalStagingBuffer.buffer, vertexBuffer.buffer, dataSize);
+
+        vertexCapacity = capacity;
     }
 
-    void Mesh::CreateIndexBuffer(const u32* indices)
+    void Mesh::CreateIndexBuffer(const u32* indices, VkDeviceSize capacity)
     {
-        VkDeviceSize bufferSize = indexSize * MAX_INDICES;
+        VkDeviceSize dataSize = indexSize * indexCount;
 
-        Buffer::CopyData(globalIndexStagingBuffer, indexSize * indexCount, indices);
+        Buffer::CreateBuffer(
+            capacity,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            // specifies that data is accessible on the CPU.
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
+            // Ensures that CPU and GPU memory are consistent across both devices.
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            OUT globalIndexStagingBuffer.buffer,
+            OUT globalIndexStagingBuffer.bufferMemory);
+
+        Buffer::CopyData(globalIndexStagingBuffer, dataSize, indices);
 
         Buffer::CreateBuffer(
-                bufferSize,
+            capacity,
             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             // specifies that data is accessible on the CPU.
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            indexBuffer.buffer,
-            indexBuffer.bufferMemory
+            OUT indexBuffer.buffer,
+            OUT indexBuffer.bufferMemory
         );
 
-        Buffer::CopyBuffer(globalIndexStagingBuffer.buffer, indexBuffer.buffer, bufferSize);
+        Buffer::CopyBuffer(globalIndexStagingBuffer.buffer, indexBuffer.buffer, dataSize);
+
+        indexCapacity = capacity;
+    }
+
+    // Buffer destruction is deferred, so buffers can be replaced while frames using them are in flight.
+    void Mesh::DestroyVertexBuffers()
+    {
+        Buffer::DestroyBuffer(vertexBuffer);
+        Buffer::DestroyBuffer(globalStagingBuffer);
+
+        vertexCapacity = 0;
+    }
+
+    void Mesh::DestroyIndexBuffers()
+    {
+        Buffer::DestroyBuffer(indexBuffer);
+        Buffer::DestroyBuffer(globalIndexStagingBuffer);
+
+        indexCapacity = 0;
     }
 
     void Mesh::Bind(VkCommandBuffer commandBuffer)
@@ -122,9 +143,14 @@ namespace SnekVk
             VkBuffer buffers[] = {vertexBuffer.buffer};
             VkDeviceSize offsets[] = {0};
             vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+            RenderStatistics::Increment(RenderStatistics::VERTEX_BUFFER_BINDS);
         }
 
-        if (hasIndexBuffer) vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+        if (hasIndexBuffer) 
+        {
+            vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+            RenderStatistics::Increment(RenderStatistics::INDEX_BUFFER_BINDS);
+        }
     }
 
     void Mesh::UpdateVertices(const Mesh::MeshData& meshData)
@@ -142,31 +168,41 @@ namespace SnekVk
     {
         if (vertexCount == 0) return;
 
-        if (!hasVertexBuffer)
+        VkDeviceSize dataSize = vertexSize * vertexCount;
+
+        if (!hasVertexBuffer || dataSize > vertexCapacity)
         {
-            CreateVertexBuffers(vertices);
+            VkDeviceSize capacity = GrowCapacity(vertexCapacity, dataSize);
+
+            if (hasVertexBuffer) DestroyVertexBuffers();
+
+            CreateVertexBuffers(vertices, capacity);
             hasVertexBuffer = true;
             return;
         }
 
-        Buffer::CopyData(globalStagingBuffer, vertexSize * vertexCount, vertices);
-        Buffer::CopyBuffer(globalStagingBuffer.buffer, vertexBuffer.buffer, vertexSize * vertexCount);
+        Buffer::CopyData(globalStagingBuffer, dataSize, vertices);
+        Buffer::CopyBuffer(globalStagingBuffer.buffer, vertexBuffer.buffer, dataSize);
     }
 
-    void Mesh::UpdateIndexBuffer(u32* indices)
+    void Mesh::UpdateIndexBuffer(const u32* indices)
     {
         if (indexCount == 0) return;
 
-        if (!hasIndexBuffer)
+        VkDeviceSize dataSize = indexSize * indexCount;
+
+        if (!hasIndexBuffer || dataSize > indexCapacity)
         {
-            CreateIndexBuffer(indices);
+            VkDeviceSize capacity = GrowCapacity(indexCapacity, dataSize);
+
+            if (hasIndexBuffer) DestroyIndexBuffers();
+
+            CreateIndexBuffer(indices, capacity);
             hasIndexBuffer = true;
             return;
         }
 
-        VkDeviceSize indexSize = sizeof(u32) * indexCount;
-
-        Buffer::CopyData(globalIndexStagingBuffer, indexSize, indices);
-        Buffer::CopyBuffer(globalIndexStagingBuffer.buffer, indexBuffer.buffer, indexSize);
+        Buffer::CopyData(globalIndexStagingBuffer, dataSize, indices);
+        Buffer::CopyBuffer(globalIndexStagingBuffer.buffer, indexBuffer.buffer, dataSize);
     }
-}
\ No newline at end of file
+}
@@ -39,15 +39,12 @@ namespace SnekVk
     {
         public:
 
-        static constexpr size_t MAX_VERTICES = 10000;
-        static constexpr size_t MAX_INDICES = 100000;
-
         struct MeshData
         {
             u64 vertexSize {0};
             const void* vertices {nullptr};
             u32 vertexCount {0}; 
-            u32* indices {nullptr}; 
+            const u32* indices {nullptr}; 
             u32 indexCount {0};
         };
 
@@ -62,7 +59,7 @@ namespace SnekVk
         void UpdateVertices(const Mesh::MeshData& meshData);
 
         void UpdateVertexBuffer(const void* vertices);
-        void UpdateIndexBuffer(u32* indices);
+        void UpdateIndexBuffer(const u32* indices);
 
         void Bind(VkCommandBuffer commandBuffer);
         void DestroyMesh();
@@ -79,8 +76,13 @@ namespace SnekVk
         // bindlessly render models. This would require an allocation
         // of a single, large vertex and index buffer. 
 
-        void CreateVertexBuffers(const void* vertices);
-        void CreateIndexBuffer(const u32* indices);
+        // Buffers are created with room for the given number of bytes, and re-created with more 
+        // room when an update doesn't fit.
+        void CreateVertexBuffers(const void* vertices, VkDeviceSize capacity);
+        void CreateIndexBuffer(const u32* indices, VkDeviceSize capacity);
+
+        void DestroyVertexBuffers();
+        void DestroyIndexBuffers();
 
         Buffer::Buffer globalStagingBuffer;
         Buffer::Buffer globalIndexStagingBuffer;
@@ -97,6 +99,9 @@ namespace SnekVk
         u64 indexSize {sizeof(u32)};
         u64 vertexSize = 0;
 
+        VkDeviceSize vertexCapacity = 0;
+        VkDeviceSize indexCapacity = 0;
+
         bool isFreed = false;
     };
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "MeshCache.h"
+#include "ObjLoader.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+
+namespace SnekVk
+{
+    static_assert(std::is_trivially_copyable<MeshCache::Header>::value, "Cache headers are read straight from the file");
+    static_assert(sizeof(MeshCache::Header) == 144, "Changing the header's size requires a new VERSION");
+
+    static const MeshCache::Attribute VERTEX_LAYOUT[] = {
+        { static_cast<u32>(offsetof(Vertex, position)), VertexDescription::VEC3 },
+        { static_cast<u32>(offsetof(Vertex, color)), VertexDescription::VEC3 },
+        { static_cast<u32>(offsetof(Vertex, normal)), VertexDescription::VEC3 },
+        { static_cast<u32>(offsetof(Vertex, uv)), VertexDescription::VEC2 }
+    };
+
+    static constexpr u32 VERTEX_ATTRIBUTE_COUNT = sizeof(VERTEX_LAYOUT) / sizeof(VERTEX_LAYOUT[0]);
+
+    static_assert(VERTEX_ATTRIBUTE_COUNT <= MeshCache::MAX_ATTRIBUTES, "Vertex has too many attributes to cache");
+
+    static u64 AlignOffset(u64 offset)
+    {
+        return (offset + MeshCache::BLOB_ALIGNMENT - 1) & ~(MeshCache::BLOB_ALIGNMENT - 1);
+    }
+
+    static bool IsValid(const MeshCache::Header& header, u64 sourceHash, u32 flags, u64 fileSize)
+    {
+        if (header.magic != MeshCache::MAGIC || header.version != MeshCache::VERSION) return false;
+
+        if (header.sourceHash != sourceHash || header.flags != flags) return false;
+
+        if (header.indexSize != sizeof(u32)) return false;
+
+        if (header.vertexSize != sizeof(Vertex) || header.attributeCount != VERTEX_ATTRIBUTE_COUNT) return false;
+
+        for (u32 i = 0; i < VERTEX_ATTRIBUTE_COUNT; i++)
+        {
+            if (header.attributes[i].offset != VERTEX_LAYOUT[i].offset ||
+                header.attributes[i].type != VERTEX_LAYOUT[i].type) return false;
+        }
+
+        u64 vertexEnd = header.vertexOffset + u64(header.vertexCount) * header.vertexSize;
+        u64 indexEnd = header.indexOffset + u64(header.indexCount) * sizeof(u32);
+
+        return header.vertexOffset >= sizeof(MeshCache::Header) &&
+               header.vertexOffset % MeshCache::BLOB_ALIGNMENT == 0 &&
+               header.indexOffset % MeshCache::BLOB_ALIGNMENT == 0 &&
+               header.indexOffset >= vertexEnd &&
+               indexEnd <= fileSize;
+    }
+
+    bool MeshCache::MappedMesh::Open(const char* cachePath, u64 sourceHash, u32 flags)
+    {
+        header = nullptr;
+
+        if (!file.Open(cachePath)) return false;
+
+        if (file.Size() < sizeof(Header) ||
+            !IsValid(*reinterpret_cast<const Header*>(file.Data()), sourceHash, flags, file.Size()))
+        {
+            file.Close();
+            return false;
+        }
+
+        header = reinterpret_cast<const Header*>(file.Data());
+
+        return true;
+    }
+
+    Mesh::MeshData MeshCache::MappedMesh::GetMeshData() const
+    {
+        return {
+            header->vertexSize,
+            file.Data() + header->vertexOffset,
+            header->vertexCount,
+            reinterpret_cast<const u32*>(file.Data() + header->indexOffset),
+            header->indexCount
+        };
+    }
+
+    std::string MeshCache::GetCachePath(const char* sourcePath)
+    {
+        return std::string(sourcePath) + FILE_EXTENSION;
+    }
+
+    u64 MeshCache::HashSource(const Utils::MappedFile& sourceFile)
+    {
+        return Utils::Hash64(sourceFile.Data(), sourceFile.Size());
+    }
+
+    bool MeshCache::Build(const char* sourcePath,
+                          const Utils::MappedFile& sourceFile,
+                          u32 flags,
+                          OUT std::vector<Vertex>& vertices,
+                          OUT std::vector<u32>& indices,
+                          OUT std::string& error)
+    {
+        if (!ObjLoader::Load(sourceFile.Data(), sourceFile.Size(), vertices, indices, error)) return false;
+
+        if (flags & FLAG_OPTIMISED)
+        {
+            auto result = MeshOptimiser::Optimise(vertices, indices);
+
+            SNEK_LOG_INFO("Optimised " << sourcePath << ": ACMR " << result.before.acmr << " -> " << result.after.acmr
+                          << ", ATVR " << result.before.atvr << " -> " << result.after.atvr);
+        }
+
+        return true;
+    }
+
+    static void WritePadding(std::ofstream& file, u64 offset)
+    {
+        static const char zeroes[MeshCache::BLOB_ALIGNMENT] {};
+
+        u64 position = static_cast<u64>(file.tellp());
+
+        if (offset > position) file.write(zeroes, static_cast<std::streamsize>(offset - position));
+    }
+
+    bool MeshCache::Write(const char* cachePath,
+                          u64 sourceHash,
+                          u32 flags,
+                          const std::vector<Vertex>& vertices,
+                          const std::vector<u32>& indices)
+    {
+        Header header;
+
+        header.sourceHash = sourceHash;
+        header.flags = flags;
+        header.vertexSize = sizeof(Vertex);
+        header.attributeCount = VERTEX_ATTRIBUTE_COUNT;
+
+        std::copy(std::begin(VERTEX_LAYOUT), std::end(VERTEX_LAYOUT), header.attributes);
+
+        if (!vertices.empty())
+        {
+            glm::vec3 min = vertices[0].position, max = vertices[0].position;
+
+            for (auto& vertex : vertices)
+            {
+                min = glm::min(min, vertex.position);
+                max = glm::max(max, vertex.position);
+            }
+
+            header.boundsMin[0] = min.x; header.boundsMin[1] = min.y; header.boundsMin[2] = min.z;
+            header.boundsMax[0] = max.x; header.boundsMax[1] = max.y; header.boundsMax[2] = max.z;
+        }
+
+        header.vertexCount = static_cast<u32>(vertices.size());
+        header.indexCount = static_cast<u32>(indices.size());
+
+        header.vertexOffset = AlignOffset(sizeof(Header));
+        header.indexOffset = AlignOffset(header.vertexOffset + u64(header.vertexCount) * header.vertexSize);
+
+        std::string temporaryPath = std::string(cachePath) + ".tmp";
+
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+            if (!file.is_open()) return false;
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            WritePadding(file, header.vertexOffset);
+            file.write(reinterpret_cast<const char*>(vertices.data()),
+                       static_cast<std::streamsize>(vertices.size() * sizeof(Vertex)));
+
+            WritePadding(file, header.indexOffset);
+            file.write(reinterpret_cast<const char*>(indices.data()),
+                       static_cast<std::streamsize>(indices.size() * sizeof(u32)));
+
+            if (!file.good())
+            {
+                file.close();
+                std::remove(temporaryPath.c_str());
+                return false;
+            }
+        }
+
+        // Renaming doesn't replace existing files on every platform.
+        std::remove(cachePath);
+
+        return std::rename(temporaryPath.c_str(), cachePath) == 0;
+    }
+
+    bool MeshCache::Cook(const char* sourcePath, const char* cachePath, u32 flags, OUT std::string& error)
+    {
+        Utils::MappedFile sourceFile;
+
+        if (!sourceFile.Open(sourcePath))
+        {
+            error = std::string("Cannot open file [") + sourcePath + "]";
+            return false;
+        }
+
+        std::vector<Vertex> vertices;
+        std::vector<u32> indices;
+
+        if (!Build(sourcePath, sourceFile, flags, vertices, indices, error)) return false;
+
+        if (!Write(cachePath, HashSource(sourceFile), flags, vertices, indices))
+        {
+            error = std::string("Cannot write file [") + cachePath + "]";
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Mesh/Mesh.h"
+#include "../Utils/MappedFile.h"
+#include "MeshOptimiser.h"
+
+#include <string>
+#include <vector>
+
+namespace SnekVk
+{
+    /**
+     * @brief Reads and writes pre-processed meshes, so that models don't need to be parsed and
+     * de-duplicated every time they're loaded.
+     *
+     * A cache file holds a Header, followed by the vertex and index data exactly as they're uploaded to
+     * the GPU. Cache files are memory-mapped, so loading one doesn't copy or parse anything: the mesh is
+     * copied straight from the mapping into the staging buffers. Values are stored in native byte order.
+     *
+     * Each cache file records the hash of the source file it was built from, the layout of the vertices and
+     * whether the mesh was optimised. If any of these don't match, the cache is rejected and should be rebuilt.
+     */
+    class MeshCache
+    {
+        public:
+
+        // "SNKM" in little-endian order.
+        static constexpr u32 MAGIC = 0x4D4B4E53;
+        // Must be incremented whenever the layout of the file changes.
+        static constexpr u32 VERSION = 2;
+
+        static constexpr u32 MAX_ATTRIBUTES = 8;
+        static constexpr u64 BLOB_ALIGNMENT = 16;
+
+        static constexpr const char* FILE_EXTENSION = ".snekmesh";
+
+        // Set if the mesh was reordered by MeshOptimiser.
+        static constexpr u32 FLAG_OPTIMISED = 1 << 0;
+
+        struct Attribute
+        {
+            u32 offset {0};
+            u32 type {0};
+        };
+
+        struct Header
+        {
+            u32 magic {MAGIC};
+            u32 version {VERSION};
+
+            // The Hash64 of the file the mesh was built from.
+            u64 sourceHash {0};
+
+            u32 flags {0};
+
+            u32 vertexSize {0};
+            u32 attributeCount {0};
+            Attribute attributes[MAX_ATTRIBUTES];
+
+            float boundsMin[3] {0.f, 0.f, 0.f};
+            float boundsMax[3] {0.f, 0.f, 0.f};
+
+            u32 vertexCount {0};
+            u32 indexCount {0};
+            u32 indexSize {sizeof(u32)};
+
+            // Byte offsets from the start of the file, aligned to BLOB_ALIGNMENT.
+            u64 vertexOffset {0};
+            u64 indexOffset {0};
+        };
+
+        /**
+         * @brief A cache file which has been mapped into memory. The mesh data stays valid for as long as
+         * the file is open.
+         */
+        class MappedMesh
+        {
+            public:
+
+            /**
+             * @brief Maps and validates a cache file.
+             *
+             * @param cachePath the path of the cache file.
+             * @param sourceHash the hash of the file the mesh should have been built from.
+             * @param flags the flags the mesh should have been built with.
+             * @returns true if the file exists and is up to date.
+             */
+            bool Open(const char* cachePath, u64 sourceHash, u32 flags);
+
+            const Header& GetHeader() const { return *header; }
+
+            Mesh::MeshData GetMeshData() const;
+
+            private:
+
+            Utils::MappedFile file;
+            const Header* header {nullptr};
+        };
+
+        /**
+         * @brief Returns the path of the cache file for a model, which sits alongside it.
+         */
+        static std::string GetCachePath(const char* sourcePath);
+
+        /**
+         * @brief Hashes the contents of a source file. This is used as the cache key.
+         */
+        static u64 HashSource(const Utils::MappedFile& sourceFile);
+
+        /**
+         * @brief Loads a model into the form it's cached in, optimising it if FLAG_OPTIMISED is set.
+         *
+         * @param sourcePath the path of the model, which is used in log messages.
+         * @param sourceFile the contents of the model.
+         * @param flags the flags the mesh is being built with.
+         * @param error a description of the problem if the model couldn't be loaded.
+         * @returns true if the model was loaded.
+         */
+        static bool Build(const char* sourcePath,
+                          const Utils::MappedFile& sourceFile,
+                          u32 flags,
+                          OUT std::vector<Vertex>& vertices,
+                          OUT std::vector<u32>& indices,
+                          OUT std::string& error);
+
+        /**
+         * @brief Writes a cache file. The file is written under a temporary name and then renamed, so a
+         * partially written file is never picked up.
+         *
+         * @returns true if the file was written.
+         */
+        static bool Write(const char* cachePath,
+                          u64 sourceHash,
+                          u32 flags,
+                          const std::vector<Vertex>& vertices,
+                          const std::vector<u32>& indices);
+
+        /**
+         * @brief Loads a model and writes its cache file.
+         *
+         * @param sourcePath the path of the model.
+         * @param cachePath the path to write the cache to.
+         * @param flags the flags to build the mesh with.
+         * @param error a description of the problem if the cache couldn't be written.
+         * @returns true if the cache was written.
+         */
+        static bool Cook(const char* sourcePath, const char* cachePath, u32 flags, OUT std::string& error);
+    };
+}
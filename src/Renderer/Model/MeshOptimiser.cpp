@@ -0,0 +1,395 @@
+#include "MeshOptimiser.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SnekVk
+{
+    std::atomic<bool> MeshOptimiser::isEnabled {true};
+
+    static constexpr u32 INVALID_INDEX = ~0u;
+
+    // Scoring constants from Forsyth's "Linear-Speed Vertex Cache Optimisation".
+    static constexpr float CACHE_DECAY_POWER = 1.5f;
+    static constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    static constexpr float VALENCE_BOOST_SCALE = 2.f;
+    static constexpr float VALENCE_BOOST_POWER = .5f;
+    // Vertices with more live triangles than this all get the same valence boost.
+    static constexpr u32 MAX_VALENCE = 32;
+
+    /**
+     * Vertex scores only depend on a vertex's position in the cache and its number of remaining
+     * triangles, so they're calculated up front.
+     */
+    struct VertexScoreTable
+    {
+        float cacheScores[MeshOptimiser::CACHE_SIZE];
+        float valenceScores[MAX_VALENCE + 1];
+
+        VertexScoreTable()
+        {
+            for (u32 i = 0; i < MeshOptimiser::CACHE_SIZE; i++)
+            {
+                // The vertices of the last triangle score the same, so that it doesn't matter which way
+                // round the triangle was added.
+                cacheScores[i] = i < 3 ? LAST_TRIANGLE_SCORE
+                    : std::pow(1.f - static_cast<float>(i - 3) / (MeshOptimiser::CACHE_SIZE - 3), CACHE_DECAY_POWER);
+            }
+
+            valenceScores[0] = 0.f;
+
+            for (u32 i = 1; i <= MAX_VALENCE; i++)
+            {
+                valenceScores[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+            }
+        }
+
+        float GetScore(i32 cachePosition, u32 liveTriangles) const
+        {
+            // Vertices without any triangles left can never be picked.
+            if (liveTriangles == 0) return -1.f;
+
+            float score = valenceScores[std::min(liveTriangles, MAX_VALENCE)];
+
+            return cachePosition < 0 ? score : score + cacheScores[cachePosition];
+        }
+    };
+
+    /**
+     * Simulates a FIFO cache with timestamps: a vertex is still cached if fewer than cacheSize vertices
+     * have been transformed since it was. Flushing the cache only requires advancing the time.
+     */
+    struct FifoCache
+    {
+        std::vector<u32> timestamps;
+        u32 time;
+        u32 cacheSize;
+
+        FifoCache(size_t vertexCount, u32 size) : timestamps(vertexCount, 0), time(size + 1), cacheSize(size) {}
+
+        u32 Transform(u32 index)
+        {
+            if (time - timestamps[index] <= cacheSize) return 0;
+
+            timestamps[index] = time++;
+            return 1;
+        }
+
+        u32 TransformTriangle(const u32* triangle)
+        {
+            return Transform(triangle[0]) + Transform(triangle[1]) + Transform(triangle[2]);
+        }
+
+        void Flush()
+        {
+            time += cacheSize + 1;
+        }
+    };
+
+    MeshOptimiser::Result MeshOptimiser::Optimise(OUT std::vector<Vertex>& vertices, OUT std::vector<u32>& indices)
+    {
+        Result result;
+
+        result.before = AnalyseVertexCache(indices, vertices.size());
+
+        OptimiseVertexCache(indices, vertices.size());
+        OptimiseOverdraw(indices, vertices);
+        OptimiseVertexFetch(vertices, indices);
+
+        result.after = AnalyseVertexCache(indices, vertices.size());
+
+        return result;
+    }
+
+    void MeshOptimiser::OptimiseVertexCache(OUT std::vector<u32>& indices, size_t vertexCount)
+    {
+        static const VertexScoreTable scoreTable;
+
+        size_t triangleCount = indices.size() / 3;
+
+        if (triangleCount == 0) return;
+
+        // Each vertex's triangles are stored contiguously. Added triangles are swapped to the end of the
+        // vertex's range, so its first liveTriangles entries are the ones which haven't been added yet.
+        std::vector<u32> liveTriangles(vertexCount, 0);
+
+        for (auto index : indices) liveTriangles[index]++;
+
+        std::vector<u32> adjacencyOffsets(vertexCount + 1, 0);
+
+        for (size_t i = 0; i < vertexCount; i++) adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+
+        std::vector<u32> adjacency(indices.size());
+        std::vector<u32> adjacencyCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+        for (size_t i = 0; i < indices.size(); i++) adjacency[adjacencyCursors[indices[i]]++] = static_cast<u32>(i / 3);
+
+        std::vector<float> vertexScores(vertexCount);
+
+        for (size_t i = 0; i < vertexCount; i++) vertexScores[i] = scoreTable.GetScore(-1, liveTriangles[i]);
+
+        std::vector<u8> isAdded(triangleCount, 0);
+        std::vector<u32> result;
+        result.reserve(indices.size());
+
+        u32 cache[CACHE_SIZE + 3];
+        u32 cacheCount = 0;
+
+        u32 bestTriangle = INVALID_INDEX;
+        // Used to find a new triangle when none of the cached vertices have any left.
+        size_t nextTriangle = 0;
+
+        for (size_t added = 0; added < triangleCount; added++)
+        {
+            if (bestTriangle == INVALID_INDEX)
+            {
+                while (isAdded[nextTriangle]) nextTriangle++;
+                bestTriangle = static_cast<u32>(nextTriangle);
+            }
+
+            const u32* triangle = &indices[bestTriangle * 3];
+
+            result.insert(result.end(), triangle, triangle + 3);
+            isAdded[bestTriangle] = 1;
+
+            for (u32 i = 0; i < 3; i++)
+            {
+                u32 vertex = triangle[i];
+
+                u32* begin = &adjacency[adjacencyOffsets[vertex]];
+                u32* end = begin + liveTriangles[vertex];
+
+                std::swap(*std::find(begin, end, bestTriangle), *(end - 1));
+                liveTriangles[vertex]--;
+            }
+
+            // The triangle's vertices move to the front of the cache, pushing the rest back.
+            u32 newCache[CACHE_SIZE + 3];
+            u32 newCacheCount = 0;
+
+            for (u32 i = 0; i < 3; i++)
+            {
+                if (std::find(newCache, newCache + newCacheCount, triangle[i]) == newCache + newCacheCount)
+                {
+                    newCache[newCacheCount++] = triangle[i];
+                }
+            }
+
+            for (u32 i = 0; i < cacheCount; i++)
+            {
+                u32 vertex = cache[i];
+
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                {
+                    newCache[newCacheCount++] = vertex;
+                }
+            }
+
+            for (u32 i = CACHE_SIZE; i < newCacheCount; i++)
+            {
+                u32 vertex = newCache[i];
+
+                vertexScores[vertex] = scoreTable.GetScore(-1, liveTriangles[vertex]);
+            }
+
+            cacheCount = std::min(newCacheCount, CACHE_SIZE);
+
+            for (u32 i = 0; i < cacheCount; i++)
+            {
+                u32 vertex = newCache[i];
+
+                cache[i] = vertex;
+                vertexScores[vertex] = scoreTable.GetScore(static_cast<i32>(i), liveTriangles[vertex]);
+            }
+
+            // Only triangles which use a cached vertex have changed score, so the next triangle is picked
+            // from those.
+            bestTriangle = INVALID_INDEX;
+            float bestScore = -1.f;
+
+            for (u32 i = 0; i < cacheCount; i++)
+            {
+                u32 vertex = cache[i];
+                const u32* candidates = &adjacency[adjacencyOffsets[vertex]];
+
+                for (u32 j = 0; j < liveTriangles[vertex]; j++)
+                {
+                    const u32* candidate = &indices[candidates[j] * 3];
+
+                    float score = vertexScores[candidate[0]] + vertexScores[candidate[1]] + vertexScores[candidate[2]];
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = candidates[j];
+                    }
+                }
+            }
+        }
+
+        indices.swap(result);
+    }
+
+    void MeshOptimiser::OptimiseOverdraw(OUT std::vector<u32>& indices,
+                                         const std::vector<Vertex>& vertices,
+                                         float threshold)
+    {
+        size_t triangleCount = indices.size() / 3;
+
+        if (triangleCount < 2) return;
+
+        FifoCache cache(vertices.size(), FIFO_CACHE_SIZE);
+
+        // Triangles which miss the cache entirely can be moved without losing any re-use.
+        std::vector<u32> hardBoundaries;
+
+        for (u32 i = 0; i < triangleCount; i++)
+        {
+            if (cache.TransformTriangle(&indices[i * 3]) == 3 || i == 0) hardBoundaries.push_back(i);
+        }
+
+        hardBoundaries.push_back(static_cast<u32>(triangleCount));
+
+        // Each hard cluster is split further wherever the ACMR so far is within the threshold of the
+        // cluster's own ACMR, since splitting there costs little re-use.
+        std::vector<u32> clusterStarts;
+
+        for (size_t i = 0; i + 1 < hardBoundaries.size(); i++)
+        {
+            u32 start = hardBoundaries[i], end = hardBoundaries[i + 1];
+
+            cache.Flush();
+
+            u32 clusterMisses = 0;
+
+            for (u32 triangle = start; triangle < end; triangle++)
+            {
+                clusterMisses += cache.TransformTriangle(&indices[triangle * 3]);
+            }
+
+            float targetAcmr = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+            clusterStarts.push_back(start);
+            cache.Flush();
+
+            u32 runningMisses = 0, runningTriangles = 0;
+
+            for (u32 triangle = start; triangle + 1 < end; triangle++)
+            {
+                runningMisses += cache.TransformTriangle(&indices[triangle * 3]);
+                runningTriangles++;
+
+                if (static_cast<float>(runningMisses) <= targetAcmr * static_cast<float>(runningTriangles))
+                {
+                    clusterStarts.push_back(triangle + 1);
+
+                    cache.Flush();
+                    runningMisses = runningTriangles = 0;
+                }
+            }
+        }
+
+        clusterStarts.push_back(static_cast<u32>(triangleCount));
+
+        size_t clusterCount = clusterStarts.size() - 1;
+
+        if (clusterCount < 2) return;
+
+        glm::vec3 meshCentre {0.f, 0.f, 0.f};
+
+        for (auto& vertex : vertices) meshCentre += vertex.position;
+
+        meshCentre /= static_cast<float>(vertices.size());
+
+        // Clusters are sorted by how far they face away from the centre of the mesh. Outward facing
+        // clusters are on the outside of the mesh, so they're the most likely to occlude others.
+        std::vector<float> clusterKeys(clusterCount);
+
+        for (size_t i = 0; i < clusterCount; i++)
+        {
+            glm::vec3 centroid {0.f, 0.f, 0.f};
+            glm::vec3 normal {0.f, 0.f, 0.f};
+            float area = 0.f;
+
+            for (u32 triangle = clusterStarts[i]; triangle < clusterStarts[i + 1]; triangle++)
+            {
+                const glm::vec3& a = vertices[indices[triangle * 3]].position;
+                const glm::vec3& b = vertices[indices[triangle * 3 + 1]].position;
+                const glm::vec3& c = vertices[indices[triangle * 3 + 2]].position;
+
+                // The cross product's length is twice the triangle's area, so larger triangles weigh more.
+                glm::vec3 triangleNormal = glm::cross(b - a, c - a);
+                float triangleArea = glm::length(triangleNormal);
+
+                centroid += (a + b + c) * (triangleArea / 3.f);
+                normal += triangleNormal;
+                area += triangleArea;
+            }
+
+            float normalLength = glm::length(normal);
+
+            if (area > 0.f) centroid /= area;
+            if (normalLength > 0.f) normal /= normalLength;
+
+            clusterKeys[i] = glm::dot(centroid - meshCentre, normal);
+        }
+
+        std::vector<u32> clusterOrder(clusterCount);
+
+        for (u32 i = 0; i < clusterCount; i++) clusterOrder[i] = i;
+
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterKeys](u32 left, u32 right) {
+            return clusterKeys[left] > clusterKeys[right];
+        });
+
+        std::vector<u32> result;
+        result.reserve(indices.size());
+
+        for (auto cluster : clusterOrder)
+        {
+            result.insert(result.end(),
+                          indices.begin() + clusterStarts[cluster] * 3,
+                          indices.begin() + clusterStarts[cluster + 1] * 3);
+        }
+
+        indices.swap(result);
+    }
+
+    void MeshOptimiser::OptimiseVertexFetch(OUT std::vector<Vertex>& vertices, OUT std::vector<u32>& indices)
+    {
+        std::vector<u32> remap(vertices.size(), INVALID_INDEX);
+        std::vector<Vertex> result;
+        result.reserve(vertices.size());
+
+        for (auto& index : indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = static_cast<u32>(result.size());
+                result.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        vertices.swap(result);
+    }
+
+    MeshOptimiser::CacheStatistics MeshOptimiser::AnalyseVertexCache(const std::vector<u32>& indices,
+                                                                     size_t vertexCount,
+                                                                     u32 cacheSize)
+    {
+        CacheStatistics statistics;
+
+        if (indices.size() < 3 || vertexCount == 0) return statistics;
+
+        FifoCache cache(vertexCount, cacheSize);
+
+        for (auto index : indices) statistics.verticesTransformed += cache.Transform(index);
+
+        statistics.acmr = static_cast<float>(statistics.verticesTransformed) / static_cast<float>(indices.size() / 3);
+        statistics.atvr = static_cast<float>(statistics.verticesTransformed) / static_cast<float>(vertexCount);
+
+        return statistics;
+    }
+}
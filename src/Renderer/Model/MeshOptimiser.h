@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Mesh/Mesh.h"
+
+#include <atomic>
+#include <vector>
+
+namespace SnekVk
+{
+    /**
+     * @brief Reorders indexed triangle meshes so that they're cheaper to draw.
+     *
+     * Optimisation runs in three passes, which should be applied in order:
+     *
+     * 1. OptimiseVertexCache reorders triangles so that recently transformed vertices are re-used,
+     *    using Tom Forsyth's linear-speed vertex cache optimisation.
+     * 2. OptimiseOverdraw splits the result into clusters which keep most of that re-use, and draws
+     *    clusters which face away from the centre of the mesh first, so that they occlude the rest.
+     * 3. OptimiseVertexFetch reorders the vertices into the order they're first used, so that vertex
+     *    fetches read memory sequentially.
+     *
+     * None of the passes change the triangles themselves, so the mesh looks the same after optimisation.
+     */
+    class MeshOptimiser
+    {
+        public:
+
+        // The cache size the triangle order is optimised for, as recommended by Forsyth.
+        static constexpr u32 CACHE_SIZE = 32;
+        // The FIFO cache size used to measure meshes. This is close to the reuse window of most GPUs.
+        static constexpr u32 FIFO_CACHE_SIZE = 16;
+        // Clusters are split whenever they reach this multiple of their cache optimised ACMR.
+        static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+
+        struct CacheStatistics
+        {
+            u32 verticesTransformed {0};
+            // Average Cache Miss Ratio: vertices transformed per triangle, from 0.5 (ideal) to 3.
+            float acmr {0.f};
+            // Average Transformed Vertex Ratio: vertices transformed per vertex, from 1 (ideal) upwards.
+            float atvr {0.f};
+        };
+
+        struct Result
+        {
+            CacheStatistics before;
+            CacheStatistics after;
+        };
+
+        /**
+         * @brief Enables or disables optimisation when models are loaded.
+         */
+        static void SetEnabled(bool enabled) { isEnabled.store(enabled, std::memory_order_relaxed); }
+
+        static bool IsEnabled() { return isEnabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Runs every optimisation pass over a mesh.
+         *
+         * @returns the cache statistics before and after optimisation.
+         */
+        static Result Optimise(OUT std::vector<Vertex>& vertices, OUT std::vector<u32>& indices);
+
+        /**
+         * @brief Reorders triangles to improve post-transform vertex cache re-use.
+         *
+         * @param indices three indices per triangle.
+         * @param vertexCount the number of vertices the indices refer to.
+         */
+        static void OptimiseVertexCache(OUT std::vector<u32>& indices, size_t vertexCount);
+
+        /**
+         * @brief Reorders clusters of triangles to reduce overdraw. The indices should already be optimised
+         * for the vertex cache.
+         *
+         * @param threshold how much worse than the input each cluster's ACMR may become. Higher values
+         * make smaller clusters, which trade vertex cache re-use for less overdraw.
+         */
+        static void OptimiseOverdraw(OUT std::vector<u32>& indices,
+                                     const std::vector<Vertex>& vertices,
+                                     float threshold = OVERDRAW_THRESHOLD);
+
+        /**
+         * @brief Reorders vertices into the order they're first referenced, and updates the indices to
+         * match. Vertices which aren't referenced are removed.
+         */
+        static void OptimiseVertexFetch(OUT std::vector<Vertex>& vertices, OUT std::vector<u32>& indices);
+
+        /**
+         * @brief Measures how well a mesh uses a FIFO vertex cache.
+         */
+        static CacheStatistics AnalyseVertexCache(const std::vector<u32>& indices,
+                                                  size_t vertexCount,
+                                                  u32 cacheSize = FIFO_CACHE_SIZE);
+
+        private:
+
+        static std::atomic<bool> isEnabled;
+    };
+}
@@ -1,23 +1,12 @@
 #include "Model.h"
-
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
+#include "MeshCache.h"
+#include "../Profiling/CpuProfiler.h"
+#include "../Profiling/RenderStatistics.h"
 
 #include <cstring>
 
 namespace std 
 {
-    template<>
-    struct hash<SnekVk::Vertex>
-    {
-        size_t operator()(const SnekVk::Vertex &vertex) const 
-        {
-            size_t seed = 0;
-            SnekVk::Utils::HashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
-            return seed;
-        };
-    };
-
     template<>
     struct hash<SnekVk::Vertex2D>
     {
@@ -55,63 +44,34 @@ namespace SnekVk
 
     void Model::LoadModelFromFile(const char* filePath)
     {
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn, err;
-
-        SNEK_ASSERT(tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filePath),
-            warn + err);
-        
+        CPU_PROFILE_SCOPE("Model::LoadModelFromFile");
+
+        Utils::MappedFile sourceFile;
+
+        SNEK_ASSERT(sourceFile.Open(filePath), std::string("Cannot open file [") + filePath + "]");
+
+        u64 sourceHash = MeshCache::HashSource(sourceFile);
+        std::string cachePath = MeshCache::GetCachePath(filePath);
+        u32 cacheFlags = MeshOptimiser::IsEnabled() ? MeshCache::FLAG_OPTIMISED : 0;
+
+        MeshCache::MappedMesh cachedMesh;
+
+        if (cachedMesh.Open(cachePath.c_str(), sourceHash, cacheFlags))
+        {
+            modelMesh.LoadVertices(cachedMesh.GetMeshData());
+            return;
+        }
+
         std::vector<Vertex> objVertices;
         std::vector<u32> objIndices;
-        std::unordered_map<Vertex, u32> uniqueVertices{};
+        std::string error;
 
-        for (const auto& shape : shapes)
+        SNEK_ASSERT(MeshCache::Build(filePath, sourceFile, cacheFlags, objVertices, objIndices, error),
+                    filePath << ": " << error);
+
+        if (!MeshCache::Write(cachePath.c_str(), sourceHash, cacheFlags, objVertices, objIndices))
         {
-            for (const auto& index : shape.mesh.indices)
-            {
-                Vertex vertex{};
-
-                if (index.vertex_index >= 0)
-                {
-                    vertex.position = {
-                        attrib.vertices[3 * index.vertex_index + 0],
-                        attrib.vertices[3 * index.vertex_index + 1],
-                        attrib.vertices[3 * index.vertex_index + 2]
-                    };
-
-                    vertex.color = {
-                        attrib.colors[3 * index.vertex_index + 0],
-                        attrib.colors[3 * index.vertex_index + 1],
-                        attrib.colors[3 * index.vertex_index + 2]
-                    };
-                }
-
-                if (index.normal_index >= 0)
-                {
-                    vertex.normal = {
-                        attrib.normals[3 * index.normal_index + 0],
-                        attrib.normals[3 * index.normal_index + 1],
-                        attrib.normals[3 * index.normal_index + 2]
-                    };
-                }
-
-                if (index.texcoord_index >= 0)
-                {
-                    vertex.uv = {
-                        attrib.texcoords[2 * index.texcoord_index + 0],
-                        attrib.texcoords[2 * index.texcoord_index + 1]
-                    };
-                }
-
-                if (uniqueVertices.count(vertex) == 0)
-                {
-                    uniqueVertices[vertex] = static_cast<u32>(objVertices.size());
-                    objVertices.push_back(vertex);
-                }
-                objIndices.push_back(uniqueVertices[vertex]);
-            }
+            SNEK_LOG_WARNING("Cannot write mesh cache [" << cachePath << "]");
         }
 
         modelMesh.LoadVertices(
@@ -142,7 +102,12 @@ namespace SnekVk
 
     void Model::Draw(VkCommandBuffer commandBuffer, u32 instance)
     {
-        if (modelMesh.HasIndexBuffer()) vkCmdDrawIndexed(commandBuffer, modelMesh.GetIndexCount(), 1, 0, 0, instance);
-        else vkCmdDraw(commandBuffer, modelMesh.GetVertexCount(), 1, 0, instance);
+        u32 vertexCount = modelMesh.HasIndexBuffer() ? modelMesh.GetIndexCount() : modelMesh.GetVertexCount();
+
+        if (modelMesh.HasIndexBuffer()) vkCmdDrawIndexed(commandBuffer, vertexCount, 1, 0, 0, instance);
+        else vkCmdDraw(commandBuffer, vertexCount, 1, 0, instance);
+
+        RenderStatistics::Increment(RenderStatistics::DRAW_CALLS);
+        RenderStatistics::Increment(RenderStatistics::VERTICES_DRAWN, vertexCount);
     }
 }
@@ -0,0 +1,817 @@
+#include "ObjLoader.h"
+#include "VertexTable.h"
+#include "../Utils/MappedFile.h"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace SnekVk
+{
+    // A single corner of a face. Indices are zero-based, and -1 when the attribute isn't present.
+    struct ObjCorner
+    {
+        i32 position {-1};
+        i32 texcoord {-1};
+        i32 normal {-1};
+    };
+
+    struct ObjAttributes
+    {
+        const float* positions {nullptr};
+        const float* colors {nullptr};
+        const float* normals {nullptr};
+        const float* texcoords {nullptr};
+    };
+
+    static inline Vertex MakeVertex(const ObjAttributes& attributes, const ObjCorner& corner)
+    {
+        Vertex vertex{};
+
+        if (corner.position >= 0)
+        {
+            vertex.position = {
+                attributes.positions[3 * corner.position + 0],
+                attributes.positions[3 * corner.position + 1],
+                attributes.positions[3 * corner.position + 2]
+            };
+
+            vertex.color = {
+                attributes.colors[3 * corner.position + 0],
+                attributes.colors[3 * corner.position + 1],
+                attributes.colors[3 * corner.position + 2]
+            };
+        }
+
+        if (corner.normal >= 0)
+        {
+            vertex.normal = {
+                attributes.normals[3 * corner.normal + 0],
+                attributes.normals[3 * corner.normal + 1],
+                attributes.normals[3 * corner.normal + 2]
+            };
+        }
+
+        if (corner.texcoord >= 0)
+        {
+            vertex.uv = {
+                attributes.texcoords[2 * corner.texcoord + 0],
+                attributes.texcoords[2 * corner.texcoord + 1]
+            };
+        }
+
+        return vertex;
+    }
+
+    // Runs a job for every index in [0, count), spread over at most threadCount threads (including the
+    // calling thread). Jobs are handed out one at a time, so uneven jobs still balance out.
+    template<typename Job>
+    static void ParallelFor(size_t count, u32 threadCount, Job job)
+    {
+        size_t workerCount = std::min(count, static_cast<size_t>(threadCount));
+
+        if (workerCount <= 1)
+        {
+            for (size_t i = 0; i < count; i++) job(i);
+            return;
+        }
+
+        std::atomic<size_t> nextJob {0};
+
+        auto worker = [&]() {
+            for (size_t i = nextJob++; i < count; i = nextJob++) job(i);
+        };
+
+        Utils::Array<std::future<void>> workers(workerCount - 1);
+
+        for (auto& helper : workers) helper = std::async(std::launch::async, worker);
+
+        worker();
+
+        for (auto& helper : workers) helper.get();
+    }
+
+    /**
+     * A run of triangle corners (such as a chunk or a shape) which is de-duplicated on its own, before
+     * being merged with the others.
+     */
+    struct ObjVertexBatch
+    {
+        const ObjCorner* corners {nullptr};
+        size_t count {0};
+
+        VertexTable uniqueVertices;
+        std::vector<u32> indices;
+
+        // The index of each of the batch's unique vertices in the merged list.
+        std::vector<u32> remap;
+        size_t indexOffset {0};
+    };
+
+    /**
+     * Builds the de-duplicated vertex and index lists for a set of batches. Each batch is de-duplicated in
+     * parallel, and their unique vertices are then merged in batch order. Since a batch's unique vertices
+     * are in the order they're first used, the merged vertices are too, which gives the same result as
+     * de-duplicating every corner in a single pass.
+     */
+    static void BuildVertices(const ObjAttributes& attributes,
+                              std::vector<ObjVertexBatch>& batches,
+                              u32 threadCount,
+                              OUT std::vector<Vertex>& vertices,
+                              OUT std::vector<u32>& indices)
+    {
+        ParallelFor(batches.size(), threadCount, [&](size_t i) {
+            auto& batch = batches[i];
+
+            batch.uniqueVertices.Reset(batch.count);
+            batch.indices.resize(batch.count);
+
+            for (size_t corner = 0; corner < batch.count; corner++)
+            {
+                batch.indices[corner] = batch.uniqueVertices.FindOrInsert(MakeVertex(attributes, batch.corners[corner]));
+            }
+        });
+
+        if (batches.size() == 1)
+        {
+            vertices = batches[0].uniqueVertices.TakeVertices();
+            indices = std::move(batches[0].indices);
+            return;
+        }
+
+        size_t localVertexCount = 0;
+        size_t indexCount = 0;
+
+        for (auto& batch : batches)
+        {
+            batch.indexOffset = indexCount;
+
+            localVertexCount += batch.uniqueVertices.Count();
+            indexCount += batch.count;
+        }
+
+        VertexTable mergedVertices(localVertexCount);
+
+        for (auto& batch : batches)
+        {
+            auto& batchVertices = batch.uniqueVertices.GetVertices();
+
+            batch.remap.resize(batchVertices.size());
+
+            for (size_t i = 0; i < batchVertices.size(); i++) batch.remap[i] = mergedVertices.FindOrInsert(batchVertices[i]);
+        }
+
+        indices.resize(indexCount);
+
+        ParallelFor(batches.size(), threadCount, [&](size_t i) {
+            auto& batch = batches[i];
+
+            u32* batchIndices = indices.data() + batch.indexOffset;
+
+            for (size_t corner = 0; corner < batch.count; corner++) batchIndices[corner] = batch.remap[batch.indices[corner]];
+        });
+
+        vertices = mergedVertices.TakeVertices();
+    }
+
+    // ---------------------------------------------------------------------------------------------------
+    // Parsing. Each chunk of the file is parsed independently, so relative (negative) indices can't be
+    // resolved until the number of attributes in the preceding chunks is known. The parsing rules mirror
+    // tinyobjloader's, so that both produce the same output for the same file.
+    // ---------------------------------------------------------------------------------------------------
+
+    static inline bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+
+    static inline bool IsDigit(char c)
+    {
+        return static_cast<unsigned int>(c - '0') < 10u;
+    }
+
+    static inline const char* SkipSpaces(const char* p, const char* end)
+    {
+        while (p < end && IsSpace(*p)) p++;
+        return p;
+    }
+
+    static inline const char* FindSpace(const char* p, const char* end)
+    {
+        while (p < end && !IsSpace(*p)) p++;
+        return p;
+    }
+
+    /**
+     * Parses a number of the form [sign] digits [. digits] [(e|E) [sign] digits]. This follows
+     * tinyobjloader's tryParseDouble step for step (rather than rounding correctly, like strtod), so that
+     * every value is parsed to exactly the same float.
+     */
+    static bool ParseDouble(const char* s, const char* end, OUT double& result)
+    {
+        static const double POWERS_OF_TEN[] = { 1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001 };
+        static constexpr int POWERS_OF_TEN_COUNT = sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]);
+
+        if (s >= end) return false;
+
+        double mantissa = 0.0;
+        int exponent = 0;
+        bool isNegative = false;
+        bool hasLeadingDot = false;
+
+        const char* p = s;
+
+        if (*p == '+' || *p == '-')
+        {
+            isNegative = *p == '-';
+            p++;
+            hasLeadingDot = p != end && *p == '.';
+        }
+        else if (*p == '.') hasLeadingDot = true;
+        else if (!IsDigit(*p)) return false;
+
+        if (!hasLeadingDot)
+        {
+            int digits = 0;
+
+            for (; p != end && IsDigit(*p); p++, digits++) mantissa = mantissa * 10 + static_cast<int>(*p - '0');
+
+            if (digits == 0) return false;
+        }
+
+        if (p != end && *p == '.')
+        {
+            p++;
+
+            for (int digit = 1; p != end && IsDigit(*p); p++, digit++)
+            {
+                double scale = digit < POWERS_OF_TEN_COUNT ? POWERS_OF_TEN[digit] : std::pow(10.0, -digit);
+                mantissa += static_cast<int>(*p - '0') * scale;
+            }
+        }
+
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            p++;
+
+            bool isExponentNegative = false;
+
+            if (p != end && (*p == '+' || *p == '-'))
+            {
+                isExponentNegative = *p == '-';
+                p++;
+            }
+            else if (p == end || !IsDigit(*p)) return false;
+
+            int digits = 0;
+
+            for (; p != end && IsDigit(*p); p++, digits++)
+            {
+                if (exponent > std::numeric_limits<int>::max() / 10) return false;
+                exponent = exponent * 10 + static_cast<int>(*p - '0');
+            }
+
+            if (digits == 0) return false;
+
+            if (isExponentNegative) exponent = -exponent;
+        }
+
+        result = (isNegative ? -1 : 1) *
+                 (exponent ? std::ldexp(mantissa * std::pow(5.0, exponent), exponent) : mantissa);
+
+        return true;
+    }
+
+    // Parses the next whitespace-separated number on a line, moving past it whether it's valid or not.
+    static inline bool ParseFloat(const char*& p, const char* lineEnd, OUT float& value)
+    {
+        p = SkipSpaces(p, lineEnd);
+        const char* end = FindSpace(p, lineEnd);
+
+        double result;
+        bool isValid = ParseDouble(p, end, result);
+
+        if (isValid) value = static_cast<float>(result);
+
+        p = end;
+        return isValid;
+    }
+
+    static inline float ParseFloatOr(const char*& p, const char* lineEnd, float defaultValue)
+    {
+        float value = defaultValue;
+        ParseFloat(p, lineEnd, value);
+        return value;
+    }
+
+    // Parses an integer in the same way as atoi, without moving past it.
+    static inline int ParseInt(const char* p, const char* end)
+    {
+        while (p < end && (IsSpace(*p) || *p == '\v' || *p == '\f')) p++;
+
+        bool isNegative = false;
+
+        if (p < end && (*p == '+' || *p == '-'))
+        {
+            isNegative = *p == '-';
+            p++;
+        }
+
+        int64_t value = 0;
+        for (; p < end && IsDigit(*p) && value <= std::numeric_limits<int>::max(); p++) value = value * 10 + (*p - '0');
+
+        return static_cast<int>(isNegative ? -value : value);
+    }
+
+    // Moves to the next '/', space or the end of the line.
+    static inline const char* SkipIndex(const char* p, const char* lineEnd)
+    {
+        while (p < lineEnd && *p != '/' && !IsSpace(*p)) p++;
+        return p;
+    }
+
+    struct ObjChunk
+    {
+        // Indices which are relative to the end of the attribute list have this bit set in the corner's
+        // flags. They're stored as an offset from the start of the chunk until the chunk is resolved.
+        static constexpr u8 RELATIVE_POSITION = 1 << 0;
+        static constexpr u8 RELATIVE_TEXCOORD = 1 << 1;
+        static constexpr u8 RELATIVE_NORMAL = 1 << 2;
+
+        const char* begin {nullptr};
+        const char* end {nullptr};
+
+        std::vector<float> positions;
+        std::vector<float> colors;
+        std::vector<float> normals;
+        std::vector<float> texcoords;
+
+        std::vector<ObjCorner> corners;
+        std::vector<u8> cornerFlags;
+        // The number of corners in each face, either 3 or 4.
+        std::vector<u8> faceSizes;
+
+        // Triangulated corners, filled in once every chunk has been parsed.
+        std::vector<ObjCorner> triangles;
+
+        // Set if the chunk couldn't be parsed or resolved.
+        bool hasFailed {false};
+
+        size_t PositionCount() const { return positions.size() / 3; }
+        size_t NormalCount() const { return normals.size() / 3; }
+        size_t TexcoordCount() const { return texcoords.size() / 2; }
+    };
+
+    // Converts a one-based (or negative, relative) OBJ index. Zero isn't a valid index.
+    static inline bool ParseIndex(const char* p, const char* lineEnd, i32 count, u8 relativeFlag,
+                                  OUT i32& index, OUT u8& flags)
+    {
+        int value = ParseInt(p, lineEnd);
+
+        if (value > 0) index = value - 1;
+        else if (value < 0)
+        {
+            index = count + value;
+            flags |= relativeFlag;
+        }
+        else return false;
+
+        return true;
+    }
+
+    // Parses a face corner of the form v, v/vt, v//vn or v/vt/vn.
+    static bool ParseCorner(const char*& p, const char* lineEnd, ObjChunk& chunk)
+    {
+        ObjCorner corner;
+        u8 flags = 0;
+
+        auto positionCount = static_cast<i32>(chunk.PositionCount());
+        auto normalCount = static_cast<i32>(chunk.NormalCount());
+        auto texcoordCount = static_cast<i32>(chunk.TexcoordCount());
+
+        if (!ParseIndex(p, lineEnd, positionCount, ObjChunk::RELATIVE_POSITION, corner.position, flags)) return false;
+
+        p = SkipIndex(p, lineEnd);
+
+        if (p < lineEnd && *p == '/')
+        {
+            p++;
+
+            if (p < lineEnd && *p == '/')
+            {
+                p++;
+                if (!ParseIndex(p, lineEnd, normalCount, ObjChunk::RELATIVE_NORMAL, corner.normal, flags)) return false;
+                p = SkipIndex(p, lineEnd);
+            }
+            else
+            {
+                if (!ParseIndex(p, lineEnd, texcoordCount, ObjChunk::RELATIVE_TEXCOORD, corner.texcoord, flags))
+                {
+                    return false;
+                }
+
+                p = SkipIndex(p, lineEnd);
+
+                if (p < lineEnd && *p == '/')
+                {
+                    p++;
+                    if (!ParseIndex(p, lineEnd, normalCount, ObjChunk::RELATIVE_NORMAL, corner.normal, flags)) return false;
+                    p = SkipIndex(p, lineEnd);
+                }
+            }
+        }
+
+        chunk.corners.push_back(corner);
+        chunk.cornerFlags.push_back(flags);
+
+        return true;
+    }
+
+    static bool ParseLine(const char* p, const char* lineEnd, ObjChunk& chunk)
+    {
+        p = SkipSpaces(p, lineEnd);
+
+        if (p == lineEnd || *p == '#') return true;
+
+        char second = p + 1 < lineEnd ? p[1] : '\0';
+        char third = p + 2 < lineEnd ? p[2] : '\0';
+
+        if (p[0] == 'v' && IsSpace(second))
+        {
+            p += 2;
+
+            float x = ParseFloatOr(p, lineEnd, 0.f);
+            float y = ParseFloatOr(p, lineEnd, 0.f);
+            float z = ParseFloatOr(p, lineEnd, 0.f);
+
+            // Vertex colours are an extension, and default to white when any of them are missing.
+            float r, g, b;
+            if (!(ParseFloat(p, lineEnd, r) && ParseFloat(p, lineEnd, g) && ParseFloat(p, lineEnd, b))) r = g = b = 1.f;
+
+            chunk.positions.insert(chunk.positions.end(), { x, y, z });
+            chunk.colors.insert(chunk.colors.end(), { r, g, b });
+
+            return true;
+        }
+
+        if (p[0] == 'v' && second == 'n' && IsSpace(third))
+        {
+            p += 3;
+
+            float x = ParseFloatOr(p, lineEnd, 0.f);
+            float y = ParseFloatOr(p, lineEnd, 0.f);
+            float z = ParseFloatOr(p, lineEnd, 0.f);
+
+            chunk.normals.insert(chunk.normals.end(), { x, y, z });
+
+            return true;
+        }
+
+        if (p[0] == 'v' && second == 't' && IsSpace(third))
+        {
+            p += 3;
+
+            float u = ParseFloatOr(p, lineEnd, 0.f);
+            float v = ParseFloatOr(p, lineEnd, 0.f);
+
+            chunk.texcoords.insert(chunk.texcoords.end(), { u, v });
+
+            return true;
+        }
+
+        if (p[0] == 'f' && IsSpace(second))
+        {
+            p = SkipSpaces(p + 2, lineEnd);
+
+            size_t cornerCount = 0;
+
+            while (p < lineEnd)
+            {
+                if (!ParseCorner(p, lineEnd, chunk)) return false;
+
+                cornerCount++;
+                p = SkipSpaces(p, lineEnd);
+            }
+
+            // Polygons with more than four sides need to be triangulated by ear clipping.
+            if (cornerCount > 4) return false;
+
+            // Faces need at least three corners, and are otherwise ignored.
+            if (cornerCount < 3)
+            {
+                chunk.corners.resize(chunk.corners.size() - cornerCount);
+                chunk.cornerFlags.resize(chunk.cornerFlags.size() - cornerCount);
+                return true;
+            }
+
+            chunk.faceSizes.push_back(static_cast<u8>(cornerCount));
+
+            return true;
+        }
+
+        // Lines, points, skin weights and tags can make tinyobjloader reject a file, so they're left to it.
+        if ((p[0] == 'l' || p[0] == 'p' || p[0] == 't') && IsSpace(second)) return false;
+        if (p[0] == 'v' && second == 'w' && IsSpace(third)) return false;
+
+        // Everything else (groups, materials, smoothing groups) doesn't affect the geometry.
+        return true;
+    }
+
+    // Lines can end with "\n", "\r\n" or a lone "\r".
+    static inline const char* FindLineEnd(const char* p, const char* end)
+    {
+        auto newLine = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!newLine) newLine = end;
+
+        auto carriageReturn = static_cast<const char*>(std::memchr(p, '\r', static_cast<size_t>(newLine - p)));
+
+        return carriageReturn ? carriageReturn : newLine;
+    }
+
+    static void ParseChunk(ObjChunk& chunk)
+    {
+        const char* line = chunk.begin;
+
+        while (line < chunk.end)
+        {
+            const char* lineEnd = FindLineEnd(line, chunk.end);
+
+            if (!ParseLine(line, lineEnd, chunk))
+            {
+                chunk.hasFailed = true;
+                return;
+            }
+
+            line = lineEnd + 1;
+        }
+    }
+
+    // The number of each attribute in the chunks before a chunk.
+    struct ObjChunkOffsets
+    {
+        i32 positions {0};
+        i32 normals {0};
+        i32 texcoords {0};
+    };
+
+    static inline bool ResolveIndex(i32& index, bool isRelative, i32 base, i32 count)
+    {
+        if (isRelative) index += base;
+
+        return index >= 0 && index < count;
+    }
+
+    static inline bool ResolveOptionalIndex(i32& index, bool isRelative, i32 base, i32 count)
+    {
+        return (index == -1 && !isRelative) || ResolveIndex(index, isRelative, base, count);
+    }
+
+    /**
+     * Makes every index in the chunk absolute, then splits its faces into triangles. Quads are split along
+     * their shorter diagonal.
+     */
+    static void ResolveChunk(ObjChunk& chunk,
+                             const ObjChunkOffsets& offsets,
+                             const std::vector<float>& positions,
+                             i32 normalCount,
+                             i32 texcoordCount)
+    {
+        auto positionCount = static_cast<i32>(positions.size() / 3);
+
+        for (size_t i = 0; i < chunk.corners.size(); i++)
+        {
+            auto& corner = chunk.corners[i];
+            u8 flags = chunk.cornerFlags[i];
+
+            bool isValid =
+                ResolveIndex(corner.position, flags & ObjChunk::RELATIVE_POSITION, offsets.positions, positionCount) &&
+                ResolveOptionalIndex(corner.normal, flags & ObjChunk::RELATIVE_NORMAL, offsets.normals, normalCount) &&
+                ResolveOptionalIndex(corner.texcoord, flags & ObjChunk::RELATIVE_TEXCOORD, offsets.texcoords, texcoordCount);
+
+            if (!isValid)
+            {
+                chunk.hasFailed = true;
+                return;
+            }
+        }
+
+        chunk.triangles.reserve(chunk.corners.size() * 3 / 2);
+
+        const ObjCorner* face = chunk.corners.data();
+
+        for (u8 faceSize : chunk.faceSizes)
+        {
+            if (faceSize == 3) chunk.triangles.insert(chunk.triangles.end(), { face[0], face[1], face[2] });
+            else
+            {
+                const float* v0 = &positions[3 * face[0].position];
+                const float* v1 = &positions[3 * face[1].position];
+                const float* v2 = &positions[3 * face[2].position];
+                const float* v3 = &positions[3 * face[3].position];
+
+                float e02x = v2[0] - v0[0];
+                float e02y = v2[1] - v0[1];
+                float e02z = v2[2] - v0[2];
+                float e13x = v3[0] - v1[0];
+                float e13y = v3[1] - v1[1];
+                float e13z = v3[2] - v1[2];
+
+                float sqr02 = e02x * e02x + e02y * e02y + e02z * e02z;
+                float sqr13 = e13x * e13x + e13y * e13y + e13z * e13z;
+
+                if (sqr02 < sqr13)
+                {
+                    chunk.triangles.insert(chunk.triangles.end(), { face[0], face[1], face[2], face[0], face[2], face[3] });
+                }
+                else
+                {
+                    chunk.triangles.insert(chunk.triangles.end(), { face[0], face[1], face[3], face[1], face[2], face[3] });
+                }
+            }
+
+            face += faceSize;
+        }
+    }
+
+    bool ObjLoader::Parse(const char* data,
+                          size_t size,
+                          OUT std::vector<Vertex>& vertices,
+                          OUT std::vector<u32>& indices,
+                          u32 threadCount)
+    {
+        vertices.clear();
+        indices.clear();
+
+        if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+        size_t chunkCount = std::min(std::max(size / MIN_CHUNK_SIZE, size_t(1)), size_t(threadCount));
+
+        // Chunks are split at the first line break after each evenly spaced offset.
+        std::vector<ObjChunk> chunks(chunkCount);
+
+        const char* end = data + size;
+        const char* chunkBegin = data;
+
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            const char* chunkEnd = end;
+
+            if (i + 1 < chunkCount)
+            {
+                chunkEnd = std::max(data + size * (i + 1) / chunkCount, chunkBegin);
+
+                while (chunkEnd < end && *chunkEnd != '\n' && *chunkEnd != '\r') chunkEnd++;
+                if (chunkEnd < end) chunkEnd++;
+            }
+
+            chunks[i].begin = chunkBegin;
+            chunks[i].end = chunkEnd;
+
+            chunkBegin = chunkEnd;
+        }
+
+        ParallelFor(chunkCount, threadCount, [&chunks](size_t i) { ParseChunk(chunks[i]); });
+
+        // Attribute lists are concatenated in file order. The sizes of the lists before each chunk are kept,
+        // since they're needed to resolve relative indices.
+        std::vector<ObjChunkOffsets> offsets(chunkCount);
+        ObjChunk merged;
+
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            auto& chunk = chunks[i];
+
+            if (chunk.hasFailed) return false;
+
+            offsets[i].positions = static_cast<i32>(merged.PositionCount());
+            offsets[i].normals = static_cast<i32>(merged.NormalCount());
+            offsets[i].texcoords = static_cast<i32>(merged.TexcoordCount());
+
+            merged.positions.insert(merged.positions.end(), chunk.positions.begin(), chunk.positions.end());
+            merged.colors.insert(merged.colors.end(), chunk.colors.begin(), chunk.colors.end());
+            merged.normals.insert(merged.normals.end(), chunk.normals.begin(), chunk.normals.end());
+            merged.texcoords.insert(merged.texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        }
+
+        if (merged.positions.size() / 3 > static_cast<size_t>(std::numeric_limits<i32>::max())) return false;
+
+        auto normalCount = static_cast<i32>(merged.NormalCount());
+        auto texcoordCount = static_cast<i32>(merged.TexcoordCount());
+
+        ParallelFor(chunkCount, threadCount, [&](size_t i) {
+            ResolveChunk(chunks[i], offsets[i], merged.positions, normalCount, texcoordCount);
+        });
+
+        std::vector<ObjVertexBatch> batches(chunkCount);
+
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            if (chunks[i].hasFailed) return false;
+
+            batches[i].corners = chunks[i].triangles.data();
+            batches[i].count = chunks[i].triangles.size();
+        }
+
+        ObjAttributes attributes {
+            merged.positions.data(),
+            merged.colors.data(),
+            merged.normals.data(),
+            merged.texcoords.data()
+        };
+
+        BuildVertices(attributes, batches, threadCount, vertices, indices);
+
+        return true;
+    }
+
+    bool ObjLoader::LoadWithTinyObj(std::istream& stream,
+                                    OUT std::vector<Vertex>& vertices,
+                                    OUT std::vector<u32>& indices,
+                                    OUT std::string& error)
+    {
+        vertices.clear();
+        indices.clear();
+
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn;
+
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &error, &stream))
+        {
+            error = warn + error;
+            return false;
+        }
+
+        if (shapes.empty()) return true;
+
+        // Each shape is de-duplicated separately, and then merged.
+        std::vector<std::vector<ObjCorner>> shapeCorners(shapes.size());
+        std::vector<ObjVertexBatch> batches(shapes.size());
+
+        for (size_t i = 0; i < shapes.size(); i++)
+        {
+            auto& corners = shapeCorners[i];
+
+            corners.reserve(shapes[i].mesh.indices.size());
+
+            for (const auto& index : shapes[i].mesh.indices)
+            {
+                corners.push_back({ index.vertex_index, index.texcoord_index, index.normal_index });
+            }
+
+            batches[i].corners = corners.data();
+            batches[i].count = corners.size();
+        }
+
+        ObjAttributes attributes {
+            attrib.vertices.data(),
+            attrib.colors.data(),
+            attrib.normals.data(),
+            attrib.texcoords.data()
+        };
+
+        BuildVertices(attributes, batches, std::max(std::thread::hardware_concurrency(), 1u), vertices, indices);
+
+        return true;
+    }
+
+    bool ObjLoader::LoadFromFile(const char* filePath,
+                                 OUT std::vector<Vertex>& vertices,
+                                 OUT std::vector<u32>& indices,
+                                 OUT std::string& error)
+    {
+        Utils::MappedFile file;
+
+        if (!file.Open(filePath))
+        {
+            error = std::string("Cannot open file [") + filePath + "]";
+            return false;
+        }
+
+        return Load(file.Data(), file.Size(), vertices, indices, error);
+    }
+
+    bool ObjLoader::Load(const char* data,
+                         size_t size,
+                         OUT std::vector<Vertex>& vertices,
+                         OUT std::vector<u32>& indices,
+                         OUT std::string& error)
+    {
+        if (Parse(data, size, vertices, indices)) return true;
+
+        SNEK_LOG_TRACE("Falling back to tinyobjloader");
+
+        std::istringstream stream(std::string(data, size));
+
+        return LoadWithTinyObj(stream, vertices, indices, error);
+    }
+}
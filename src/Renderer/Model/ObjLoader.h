@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Mesh/Mesh.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace SnekVk
+{
+    /**
+     * @brief Loads Wavefront OBJ files into a de-duplicated, triangulated list of vertices and indices.
+     *
+     * Files are memory-mapped and split into line-aligned chunks, which are parsed and de-duplicated on
+     * separate threads and then merged in file order. The output is identical to loading the file with
+     * tinyobjloader (which the loader falls back to for anything it doesn't handle itself, such as polygons
+     * with more than four sides, lines and points).
+     */
+    class ObjLoader
+    {
+        public:
+
+        // Files smaller than this are parsed on the calling thread.
+        static constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+        /**
+         * @brief Loads an OBJ file.
+         *
+         * @param filePath the path of the file.
+         * @param vertices the list of unique vertices, in the order they're first used.
+         * @param indices three indices per triangle.
+         * @param error a description of the problem if the file couldn't be loaded.
+         * @returns true if the file was loaded.
+         */
+        static bool LoadFromFile(const char* filePath,
+                                 OUT std::vector<Vertex>& vertices,
+                                 OUT std::vector<u32>& indices,
+                                 OUT std::string& error);
+
+        /**
+         * @brief Loads OBJ data which is already in memory, such as a mapped file.
+         */
+        static bool Load(const char* data,
+                         size_t size,
+                         OUT std::vector<Vertex>& vertices,
+                         OUT std::vector<u32>& indices,
+                         OUT std::string& error);
+
+        /**
+         * @brief Parses OBJ data which is already in memory.
+         *
+         * @param threadCount the maximum number of threads to use, or 0 to use every hardware thread.
+         * @returns false if the data is malformed or uses features which aren't supported. These
+         * should be loaded with LoadWithTinyObj instead.
+         */
+        static bool Parse(const char* data,
+                          size_t size,
+                          OUT std::vector<Vertex>& vertices,
+                          OUT std::vector<u32>& indices,
+                          u32 threadCount = 0);
+
+        /**
+         * @brief Loads OBJ data on the calling thread using tinyobjloader.
+         */
+        static bool LoadWithTinyObj(std::istream& stream,
+                                    OUT std::vector<Vertex>& vertices,
+                                    OUT std::vector<u32>& indices,
+                                    OUT std::string& error);
+    };
+}
@@ -0,0 +1,98 @@
+#include "VertexTable.h"
+
+namespace SnekVk
+{
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    // Tables are kept at most half full, which keeps probe sequences short.
+    static size_t GetCapacity(size_t count)
+    {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < count * 2) capacity *= 2;
+        return capacity;
+    }
+
+    static inline bool AreEqual(const Vertex& left, const Vertex& right)
+    {
+        return left.position == right.position && left.color == right.color &&
+               left.normal == right.normal && left.uv == right.uv;
+    }
+
+    VertexTable::VertexTable(size_t expectedCount)
+    {
+        Reset(expectedCount);
+    }
+
+    void VertexTable::Reset(size_t expectedCount)
+    {
+        size_t capacity = GetCapacity(expectedCount);
+
+        slots.assign(capacity, Slot{});
+        mask = capacity - 1;
+
+        vertices.clear();
+        vertices.reserve(expectedCount);
+    }
+
+    u32 VertexTable::FindOrInsert(const Vertex& vertex, u64 hash)
+    {
+        if ((vertices.size() + 1) * 2 > slots.size()) Rehash(slots.size() * 2);
+
+        auto shortHash = static_cast<u32>(hash >> 32);
+
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            auto& entry = slots[slot];
+
+            if (entry.index == EMPTY_SLOT)
+            {
+                entry.hash = shortHash;
+                entry.index = static_cast<u32>(vertices.size());
+
+                vertices.push_back(vertex);
+
+                return entry.index;
+            }
+
+            if (entry.hash == shortHash && AreEqual(vertices[entry.index], vertex)) return entry.index;
+        }
+    }
+
+    std::vector<Vertex> VertexTable::TakeVertices()
+    {
+        std::vector<Vertex> uniqueVertices = std::move(vertices);
+
+        Reset(0);
+
+        return uniqueVertices;
+    }
+
+    void VertexTable::Rehash(size_t capacity)
+    {
+        slots.assign(capacity, Slot{});
+        mask = capacity - 1;
+
+        for (u32 i = 0; i < static_cast<u32>(vertices.size()); i++)
+        {
+            u64 hash = Hash(vertices[i]);
+
+            size_t slot = hash & mask;
+            while (slots[slot].index != EMPTY_SLOT) slot = (slot + 1) & mask;
+
+            slots[slot] = { static_cast<u32>(hash >> 32), i };
+        }
+    }
+
+    u64 VertexTable::Hash(const Vertex& vertex)
+    {
+        // Adding zero turns -0 into +0, and leaves every other value unchanged.
+        float components[] = {
+            vertex.position.x + 0.f, vertex.position.y + 0.f, vertex.position.z + 0.f,
+            vertex.color.x + 0.f, vertex.color.y + 0.f, vertex.color.z + 0.f,
+            vertex.normal.x + 0.f, vertex.normal.y + 0.f, vertex.normal.z + 0.f,
+            vertex.uv.x + 0.f, vertex.uv.y + 0.f
+        };
+
+        return Utils::Hash64(components, sizeof(components));
+    }
+}
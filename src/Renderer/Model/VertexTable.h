@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Mesh/Mesh.h"
+
+#include <vector>
+
+namespace SnekVk
+{
+    /**
+     * @brief Collects unique vertices, giving each one an index in the order it was first added.
+     *
+     * Vertices are stored contiguously, and looked up through a flat, linearly probed hash table of
+     * indices. The table is sized up front from the largest number of vertices expected (such as a mesh's
+     * index count), so a steady stream of lookups never allocates. Vertices are compared component-wise,
+     * the same as Vertex's operator==.
+     */
+    class VertexTable
+    {
+        public:
+
+        VertexTable(size_t expectedCount = 0);
+
+        /**
+         * @brief Finds a vertex which is equal to the given one, adding it if there isn't one.
+         *
+         * @param vertex the vertex to look up.
+         * @param hash the vertex's hash, as returned by Hash.
+         * @returns the index of the vertex.
+         */
+        u32 FindOrInsert(const Vertex& vertex, u64 hash);
+
+        u32 FindOrInsert(const Vertex& vertex) { return FindOrInsert(vertex, Hash(vertex)); }
+
+        /**
+         * @brief Clears the table, making room for at least the expected number of vertices.
+         */
+        void Reset(size_t expectedCount);
+
+        size_t Count() const { return vertices.size(); }
+
+        const std::vector<Vertex>& GetVertices() const { return vertices; }
+
+        /**
+         * @brief Moves the unique vertices out of the table, leaving it empty.
+         */
+        std::vector<Vertex> TakeVertices();
+
+        /**
+         * @brief Hashes every component of a vertex. Zeroes hash the same regardless of their sign, since
+         * they compare equal.
+         */
+        static u64 Hash(const Vertex& vertex);
+
+        private:
+
+        static constexpr u32 EMPTY_SLOT = ~0u;
+
+        struct Slot
+        {
+            // The upper half of the hash, which rules out most mismatches without touching the vertex.
+            u32 hash {0};
+            u32 index {EMPTY_SLOT};
+        };
+
+        void Rehash(size_t capacity);
+
+        std::vector<Slot> slots;
+        std::vector<Vertex> vertices;
+        size_t mask {0};
+    };
+}
@@ -1,11 +1,12 @@
 #include "Pipeline.h"
+#include "PipelineRegistry.h"
 
-#include <fstream>
-#include <string>
 #include <iostream>
 
 namespace SnekVk 
 {
+    VkPipelineCache Pipeline::pipelineCache {VK_NULL_HANDLE};
+
     Pipeline::Pipeline(
         const PipelineConfig::ShaderConfig* shaders,
         u32 shaderCount,
@@ -22,64 +23,83 @@ namespace SnekVk
     {
         if (isFreed) return;
 
-        ClearPipeline();
-
-        isFreed = true;
+        DestroyPipeline();
     }
 
-    Utils::Array<char> Pipeline::ReadFile(const char* filePath)
+    void Pipeline::CreateGraphicsPipeline(
+        const PipelineConfig::ShaderConfig* shaders,
+        u32 shaderCount,
+        const PipelineConfigInfo& configInfo)
     {
-        // Read the file as binary and consume the entire file. 
-        std::ifstream file { filePath, std::ios::ate | std::ios::binary };
+        SNEK_ASSERT(shaderCount <= MAX_SHADER_MODULES, "Max allowed shader modules has been reached.");
 
-        SNEK_ASSERT(file.is_open(), std::string("Could not find file: ") + filePath);
+        // Acquire the new modules before releasing any old ones so that shared modules
+        // are never destroyed and re-read in between. 
+        VkShaderModule newModules[MAX_SHADER_MODULES];
 
-        // Since we consumed the entire file, we can tell the size by checking where
-        // the file stream is reading from (which presumably is at the end of the file).
-        u32 size = static_cast<u32>(file.tellg());
+        for (size_t i = 0; i < shaderCount; i++)
+        {
+            newModules[i] = ShaderModuleCache::Acquire(shaders[i].filePath);
+        }
 
-        Utils::Array<char> buffer(size);
-        
-        // Move to the beginning of the file. 
-        file.seekg(0);
-        
-        file.read(buffer.Data(), size);
+        // The old pipeline must be released before its modules, otherwise a freed module 
+        // handle could be re-used by a new module and match a stale registry entry. 
+        ClearPipeline();
+        ReleaseShaderModules();
 
-        file.close();
-        
-        return buffer;
+        shaderModuleCount = shaderCount;
+
+        for (size_t i = 0; i < shaderCount; i++)
+        {
+            shaderModules[i] = newModules[i];
+            shaderStages[i] = shaders[i].stage;
+        }
+
+        CreateGraphicsPipeline(configInfo);
     }
 
-    void Pipeline::CreateGraphicsPipeline(
-        const PipelineConfig::ShaderConfig* shaders,
-        u32 shaderCount,
-        const PipelineConfigInfo& configInfo)
+    void Pipeline::CreateGraphicsPipeline(const PipelineConfigInfo& configInfo)
     {
+        SNEK_ASSERT(shaderModuleCount > 0, "Cannot create graphics pipeline: no shader modules have been loaded");
+
+        VkPipeline oldPipeline = graphicsPipeline;
+
+        // Acquire the new pipeline before releasing the old one. If both share a description
+        // then the existing pipeline is simply kept rather than being destroyed and re-compiled.
+        graphicsPipeline = PipelineRegistry::Acquire(
+            configInfo, 
+            shaderModules, 
+            shaderStages, 
+            static_cast<u32>(shaderModuleCount)
+        );
 
+        if (oldPipeline != VK_NULL_HANDLE) PipelineRegistry::Release(oldPipeline);
+    }
+
+    VkPipeline Pipeline::CompileGraphicsPipeline(
+        const PipelineConfigInfo& configInfo,
+        const VkShaderModule* modules,
+        const PipelineConfig::PipelineStage* stages,
+        u32 shaderCount)
+    {
         SNEK_ASSERT(configInfo.pipelineLayout != VK_NULL_HANDLE, 
                 "Cannot create graphics pipeline: no pipeline config provided in configInfo");
         
         SNEK_ASSERT(configInfo.renderPass != VK_NULL_HANDLE, 
                 "Cannot create graphics pipeline: no renderpass config provided in configInfo");
-        
-        SNEK_ASSERT(shaderCount <= MAX_SHADER_MODULES, "Max allowed shader modules has been reached.");
 
-        shaderModuleCount = shaderCount;
-        
-        VkPipelineShaderStageCreateInfo shaderStages[shaderCount];
+        VkPipelineShaderStageCreateInfo shaderStageCreateInfos[MAX_SHADER_MODULES];
 
-        PipelineConfig::PipelineStage stages[shaderCount];
+        PipelineConfig::PipelineStage pipelineStages[MAX_SHADER_MODULES];
+        VkShaderModule pipelineModules[MAX_SHADER_MODULES];
 
         for (size_t i = 0; i < shaderCount; i++)
         {
-            auto shaderCode = ReadFile(shaders[i].filePath);
-
-            CreateShaderModule(shaderCode, OUT &shaderModules[i]);
-
-            stages[i] = shaders[i].stage;
+            pipelineStages[i] = stages[i];
+            pipelineModules[i] = modules[i];
         }
 
-        PipelineConfig::CreateDefaultPipelineStages(OUT shaderStages, stages, shaderModules, shaderCount);
+        PipelineConfig::CreateDefaultPipelineStages(OUT shaderStageCreateInfos, pipelineStages, pipelineModules, shaderCount);
 
         // In order to pass in vertex information, we must assign a set of descriptions to the shader.
         // These descriptions detail all data binding and which locations these bindings must be set to. 
@@ -100,18 +120,26 @@ namespace SnekVk
         vertexInputCreateInfo.pVertexAttributeDescriptions = attributeDescriptions.Data();
         vertexInputCreateInfo.pVertexBindingDescriptions = bindingDescriptions.Data();
 
+        // The config's internal pointers aren't stable when the config is copied, so 
+        // point them back at the config's own data. 
+        VkPipelineColorBlendStateCreateInfo colorBlendInfo = configInfo.colorBlendInfo;
+        colorBlendInfo.pAttachments = &configInfo.colorBlendAttachment;
+
+        VkPipelineDynamicStateCreateInfo dynamicStateInfo = configInfo.dynamicStateInfo;
+        dynamicStateInfo.pDynamicStates = configInfo.dynamicStateEnables.Data();
+
         // Pass in all pipeline config details to the pipeline create info struct. 
         VkGraphicsPipelineCreateInfo pipelineCreateInfo{};
         pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         pipelineCreateInfo.stageCount = shaderCount;
-        pipelineCreateInfo.pStages = shaderStages;
+        pipelineCreateInfo.pStages = shaderStageCreateInfos;
         pipelineCreateInfo.pVertexInputState = &vertexInputCreateInfo;
         pipelineCreateInfo.pInputAssemblyState = &configInfo.inputAssemblyInfo;
         pipelineCreateInfo.pViewportState = &configInfo.viewportInfo;
         pipelineCreateInfo.pRasterizationState = &configInfo.rasterizationInfo;
         pipelineCreateInfo.pMultisampleState = &configInfo.multisampleInfo;
-        pipelineCreateInfo.pColorBlendState = &configInfo.colorBlendInfo;
-        pipelineCreateInfo.pDynamicState = &configInfo.dynamicStateInfo;
+        pipelineCreateInfo.pColorBlendState = &colorBlendInfo;
+        pipelineCreateInfo.pDynamicState = &dynamicStateInfo;
         pipelineCreateInfo.pDepthStencilState = &configInfo.depthStencilInfo;
 
         pipelineCreateInfo.layout = configInfo.pipelineLayout;
@@ -123,8 +151,12 @@ namespace SnekVk
 
         auto device = VulkanDevice::GetDeviceInstance();
 
-        SNEK_ASSERT(vkCreateGraphicsPipelines(device->Device(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, OUT &graphicsPipeline) 
+        VkPipeline graphicsPipeline {VK_NULL_HANDLE};
+
+        SNEK_ASSERT(vkCreateGraphicsPipelines(device->Device(), pipelineCache, 1, &pipelineCreateInfo, nullptr, OUT &graphicsPipeline) 
             == VK_SUCCESS, "Failed to create graphics pipeline!")
+
+        return graphicsPipeline;
     }
 
     void Pipeline::RecreatePipeline(
@@ -135,38 +167,57 @@ namespace SnekVk
         CreateGraphicsPipeline(shaders, shaderCount, configInfo);
     }
 
+    void Pipeline::RecreatePipeline(const PipelineConfigInfo& configInfo)
+    {
+        CreateGraphicsPipeline(configInfo);
+    }
+
     void Pipeline::ClearPipeline()
     {
-        auto device = VulkanDevice::GetDeviceInstance();
-        // TODO: Maybe we can get away without destroying the shader modules when 
-        // re-creating the pipeline?
+        if (graphicsPipeline == VK_NULL_HANDLE) return;
+
+        PipelineRegistry::Release(graphicsPipeline);
+
+        graphicsPipeline = VK_NULL_HANDLE;
+    }
+
+    void Pipeline::ReleaseShaderModules()
+    {
         for (size_t i = 0; i < shaderModuleCount; i++)
         {
-            vkDestroyShaderModule(device->Device(), shaderModules[i], nullptr);
+            ShaderModuleCache::Release(shaderModules[i]);
+            shaderModules[i] = VK_NULL_HANDLE;
         }
-        
-        vkDestroyPipeline(device->Device(), graphicsPipeline, nullptr);
+
+        shaderModuleCount = 0;
     }
 
     void Pipeline::DestroyPipeline()
     {
         ClearPipeline();
+        ReleaseShaderModules();
         isFreed = true;
     }
 
-    void Pipeline::CreateShaderModule(Utils::Array<char>& fileData, VkShaderModule* shaderModule)
+    void Pipeline::CreatePipelineCache()
     {
-        VkShaderModuleCreateInfo createInfo {};
-        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = fileData.Size();
-        // Because the code is expected to be numerical, we need to cast the values in the 
-        // array to 32-bit unsigned integers. 
-        createInfo.pCode = reinterpret_cast<const u32*>(fileData.Data());
+        if (pipelineCache != VK_NULL_HANDLE) return;
+
+        VkPipelineCacheCreateInfo cacheCreateInfo {};
+        cacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
         auto device = VulkanDevice::GetDeviceInstance();
 
-        SNEK_ASSERT(vkCreateShaderModule(device->Device(), &createInfo, nullptr, OUT shaderModule) == VK_SUCCESS, 
-            "Failed to create shader module!");
+        SNEK_ASSERT(vkCreatePipelineCache(device->Device(), &cacheCreateInfo, nullptr, OUT &pipelineCache) == VK_SUCCESS,
+            "Failed to create pipeline cache!");
+    }
+
+    void Pipeline::DestroyPipelineCache()
+    {
+        if (pipelineCache == VK_NULL_HANDLE) return;
+
+        vkDestroyPipelineCache(VulkanDevice::GetDeviceInstance()->Device(), pipelineCache, nullptr);
+        pipelineCache = VK_NULL_HANDLE;
     }
 
     void Pipeline::Bind(VkCommandBuffer commandBuffer)
@@ -3,6 +3,7 @@
 #include "../Core.h"
 #include "../Device/VulkanDevice.h"
 #include "PipelineConfig.h"
+#include "ShaderModuleCache.h"
 
 namespace SnekVk 
 {
@@ -42,6 +43,13 @@ namespace SnekVk
         VkRenderPass renderPass{nullptr};
         u32 subPass{0}; 
 
+        // Keys describing the layout and render pass. Pipelines are only compatible with
+        // layouts and render passes which share the same description, meaning they can be 
+        // shared between objects holding different (but identical) handles. An empty key 
+        // means the handle itself is used instead.
+        std::string layoutKey;
+        std::string renderPassKey;
+
         VertexDescription::Data vertexData;
     };
 
@@ -79,6 +87,18 @@ namespace SnekVk
              **/
             static PipelineConfigInfo DefaultPipelineConfig();
 
+            /**
+             * Creates the pipeline cache shared by all pipelines. Vulkan pipeline caches are
+             * internally synchronised, so pipelines can be compiled against the cache from 
+             * multiple threads at once. 
+             **/
+            static void CreatePipelineCache();
+
+            /**
+             * Destroys the shared pipeline cache. 
+             **/
+            static void DestroyPipelineCache();
+
             /**
              * Binds a pipeline to a command buffer. This tells out command buffers that 
              * all bound buffers after this should be submitted to the same pipeline. This 
@@ -101,21 +121,32 @@ namespace SnekVk
                 const PipelineConfigInfo& configInfo
             );
 
-            // TODO: document this
+            /**
+             * Re-creates the pipeline using the shader modules it was last created with. 
+             * Shader files are not re-read from disk.
+             * @param configInfo the configuration for the new pipeline.
+             **/
+            void RecreatePipeline(const PipelineConfigInfo& configInfo);
+
+            /**
+             * Releases the Vulkan pipeline. Shader modules are kept so that the pipeline
+             * can be re-created without re-loading its shaders. The pipeline itself is only 
+             * destroyed once no other Pipelines share it.
+             **/
             void ClearPipeline();
+
+            /**
+             * Destroys the Vulkan pipeline and releases its shader modules. 
+             **/
             void DestroyPipeline();
 
         private:
 
+            friend class PipelineRegistry;
+
             static constexpr size_t MAX_SHADER_MODULES = 2;
 
-            /**
-             * Reads a file and returns the contents in binary. This is particularly
-             * useful for binary shader file formats (like spir-v).
-             * @param filePath a raw c string specifying the file path. 
-             * @returns a heap-allocated array containing the file contents.
-             **/
-            static Utils::Array<char> ReadFile(const char* filePath);
+            static VkPipelineCache pipelineCache;
 
             void CreateGraphicsPipeline(
                 const PipelineConfig::ShaderConfig* shaders,
@@ -123,21 +154,29 @@ namespace SnekVk
                 const PipelineConfigInfo& configInfo
             );
 
+            void CreateGraphicsPipeline(const PipelineConfigInfo& configInfo);
+
             /**
-             * Converts the binary shader into a vulkan shader module.  
-             * A shader module is an interface for our pipelines to actually
-             * receive shader data. 
-             * @param fileData an array containing our binary shader data.
-             * @param shaderModule a pointer to a shaderModule that we want to populate. 
+             * Compiles a new Vulkan pipeline. Only called by the PipelineRegistry when no
+             * matching pipeline exists.
              **/
-            void CreateShaderModule(Utils::Array<char>& fileData, VkShaderModule* shaderModule);
+            static VkPipeline CompileGraphicsPipeline(
+                const PipelineConfigInfo& configInfo,
+                const VkShaderModule* modules,
+                const PipelineConfig::PipelineStage* stages,
+                u32 shaderCount
+            );
+
+            void ReleaseShaderModules();
 
             /**
-             * The vulkan representation of a graphics pipeline. 
+             * The vulkan representation of a graphics pipeline. Owned by the PipelineRegistry.
              **/
-            VkPipeline graphicsPipeline;
+            VkPipeline graphicsPipeline {VK_NULL_HANDLE};
 
-            VkShaderModule shaderModules[MAX_SHADER_MODULES];
+            // Shader modules are owned by the ShaderModuleCache. 
+            VkShaderModule shaderModules[MAX_SHADER_MODULES] {VK_NULL_HANDLE};
+            PipelineConfig::PipelineStage shaderStages[MAX_SHADER_MODULES];
             size_t shaderModuleCount = 0; 
 
             bool isFreed = false;
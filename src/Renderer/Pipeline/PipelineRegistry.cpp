@@ -0,0 +1,280 @@
+#include "PipelineRegistry.h"
+#include "../DeletionQueue/DeletionQueue.h"
+
+namespace SnekVk
+{
+    std::unordered_map<std::string, PipelineRegistry::Entry> PipelineRegistry::pipelines;
+    std::unordered_map<VkPipeline, const std::string*> PipelineRegistry::pipelineKeys;
+    std::unordered_map<VkPipelineLayout, u32> PipelineRegistry::layoutReferences;
+    std::mutex PipelineRegistry::registryMutex;
+
+    VkPipeline PipelineRegistry::Acquire(
+        const PipelineConfigInfo& configInfo,
+        const VkShaderModule* modules,
+        const PipelineConfig::PipelineStage* stages,
+        u32 shaderCount)
+    {
+        std::string key = CreateKey(configInfo, modules, stages, shaderCount);
+
+        std::promise<VkPipeline> compiledPipeline;
+        std::shared_future<VkPipeline> pipeline;
+        bool shouldCompile = false;
+
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+
+            auto it = pipelines.find(key);
+
+            if (it != pipelines.end())
+            {
+                it->second.refCount++;
+                pipeline = it->second.pipeline;
+            }
+            else
+            {
+                pipeline = compiledPipeline.get_future().share();
+                pipelines[key] = { pipeline, configInfo.pipelineLayout, 1 };
+                layoutReferences[configInfo.pipelineLayout]++;
+                shouldCompile = true;
+            }
+        }
+
+        // Compile outside of the lock so that unrelated pipelines can be built in parallel.
+        // Any other thread requesting this description will wait on the future instead.
+        if (shouldCompile)
+        {
+            VkPipeline newPipeline = Pipeline::CompileGraphicsPipeline(configInfo, modules, stages, shaderCount);
+
+            // The pipeline must be releasable as soon as any waiting thread receives it.
+            {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                pipelineKeys[newPipeline] = &pipelines.find(key)->first;
+            }
+
+            compiledPipeline.set_value(newPipeline);
+        }
+
+        return pipeline.get();
+    }
+
+    void PipelineRegistry::Release(VkPipeline pipeline)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        auto keyIt = pipelineKeys.find(pipeline);
+
+        if (keyIt == pipelineKeys.end()) return;
+
+        auto it = pipelines.find(*keyIt->second);
+
+        if (--it->second.refCount > 0) return;
+
+        // The pipeline may still be bound in a frame that's in flight.
+        DeletionQueue::Enqueue([pipeline]() {
+            vkDestroyPipeline(VulkanDevice::GetDeviceInstance()->Device(), pipeline, nullptr);
+        });
+
+        DecrementLayout(it->second.layout);
+
+        pipelineKeys.erase(keyIt);
+        pipelines.erase(it);
+    }
+
+    void PipelineRegistry::RetainLayout(VkPipelineLayout layout)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        layoutReferences[layout]++;
+    }
+
+    void PipelineRegistry::ReleaseLayout(VkPipelineLayout layout)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        DecrementLayout(layout);
+    }
+
+    void PipelineRegistry::DecrementLayout(VkPipelineLayout layout)
+    {
+        auto it = layoutReferences.find(layout);
+
+        if (it == layoutReferences.end() || --it->second > 0) return;
+
+        layoutReferences.erase(it);
+
+        // Queued after any pipelines compiled with the layout, so those are destroyed first.
+        DeletionQueue::Enqueue([layout]() {
+            vkDestroyPipelineLayout(VulkanDevice::GetDeviceInstance()->Device(), layout, nullptr);
+        });
+    }
+
+    void PipelineRegistry::DestroyRegistry()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        auto device = VulkanDevice::GetDeviceInstance();
+
+        for (auto& entry : pipelines)
+        {
+            vkDestroyPipeline(device->Device(), entry.second.pipeline.get(), nullptr);
+        }
+
+        for (auto& layout : layoutReferences)
+        {
+            vkDestroyPipelineLayout(device->Device(), layout.first, nullptr);
+        }
+
+        pipelines.clear();
+        pipelineKeys.clear();
+        layoutReferences.clear();
+    }
+
+    size_t PipelineRegistry::GetPipelineCount()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        return pipelines.size();
+    }
+
+    std::string PipelineRegistry::CreateKey(
+        const PipelineConfigInfo& configInfo,
+        const VkShaderModule* modules,
+        const PipelineConfig::PipelineStage* stages,
+        u32 shaderCount)
+    {
+        std::string key;
+
+        // Shader modules are already de-duplicated by content, so their handles are enough here.
+        Utils::AppendKey(key, shaderCount);
+
+        for (size_t i = 0; i < shaderCount; i++)
+        {
+            Utils::AppendKey(key, modules[i], stages[i]);
+        }
+
+        // Vertex input
+
+        auto& vertexData = configInfo.vertexData;
+
+        Utils::AppendKey(key, vertexData.bindings.Size(), vertexData.attributes.Size());
+
+        for (size_t i = 0; i < vertexData.bindings.Size(); i++)
+        {
+            auto& binding = vertexData.bindings[i];
+            Utils::AppendKey(key, binding.binding, binding.stride, binding.inputRate);
+        }
+
+        for (size_t i = 0; i < vertexData.attributes.Size(); i++)
+        {
+            auto& attribute = vertexData.attributes[i];
+            Utils::AppendKey(key, attribute.location, attribute.binding, attribute.format, attribute.offset);
+        }
+
+        // Input assembly
+
+        auto& inputAssembly = configInfo.inputAssemblyInfo;
+        Utils::AppendKey(key, inputAssembly.topology, inputAssembly.primitiveRestartEnable);
+
+        // Viewports are dynamic, so only their counts matter.
+
+        Utils::AppendKey(key, configInfo.viewportInfo.viewportCount, configInfo.viewportInfo.scissorCount);
+
+        // Rasterization
+
+        auto& raster = configInfo.rasterizationInfo;
+        Utils::AppendKey(key,
+            raster.depthClampEnable,
+            raster.rasterizerDiscardEnable,
+            raster.polygonMode,
+            raster.cullMode,
+            raster.frontFace,
+            raster.depthBiasEnable,
+            raster.depthBiasConstantFactor,
+            raster.depthBiasClamp,
+            raster.depthBiasSlopeFactor,
+            raster.lineWidth);
+
+        // Multisampling
+
+        auto& multisample = configInfo.multisampleInfo;
+        Utils::AppendKey(key,
+            multisample.rasterizationSamples,
+            multisample.sampleShadingEnable,
+            multisample.minSampleShading,
+            multisample.alphaToCoverageEnable,
+            multisample.alphaToOneEnable);
+
+        VkSampleMask sampleMask = multisample.pSampleMask ? *multisample.pSampleMask : ~0u;
+        Utils::AppendKey(key, sampleMask);
+
+        // Color blending. The config's internal pointers aren't stable across copies, so
+        // the attachment and dynamic states are read from the config's own members.
+
+        auto& colorBlend = configInfo.colorBlendInfo;
+        auto& attachment = configInfo.colorBlendAttachment;
+        Utils::AppendKey(key, colorBlend.logicOpEnable, colorBlend.logicOp, colorBlend.attachmentCount);
+        Utils::AppendKey(key,
+            attachment.blendEnable,
+            attachment.srcColorBlendFactor,
+            attachment.dstColorBlendFactor,
+            attachment.colorBlendOp,
+            attachment.srcAlphaBlendFactor,
+            attachment.dstAlphaBlendFactor,
+            attachment.alphaBlendOp,
+            attachment.colorWriteMask);
+
+        for (auto& constant : colorBlend.blendConstants) Utils::AppendKey(key, constant);
+
+        // Depth and stencil
+
+        auto& depth = configInfo.depthStencilInfo;
+        Utils::AppendKey(key,
+            depth.depthTestEnable,
+            depth.depthWriteEnable,
+            depth.depthCompareOp,
+            depth.depthBoundsTestEnable,
+            depth.stencilTestEnable,
+            depth.minDepthBounds,
+            depth.maxDepthBounds);
+
+        for (auto& stencil : { depth.front, depth.back })
+        {
+            Utils::AppendKey(key,
+                stencil.failOp,
+                stencil.passOp,
+                stencil.depthFailOp,
+                stencil.compareOp,
+                stencil.compareMask,
+                stencil.writeMask,
+                stencil.reference);
+        }
+
+        // Dynamic state
+
+        Utils::AppendKey(key, configInfo.dynamicStateEnables.Size());
+
+        for (size_t i = 0; i < configInfo.dynamicStateEnables.Size(); i++)
+        {
+            Utils::AppendKey(key, configInfo.dynamicStateEnables[i]);
+        }
+
+        // Layouts and render passes are keyed by compatibility rather than by handle. This lets
+        // materials with their own (but identical) layouts share a pipeline, and lets pipelines
+        // survive render pass re-creation when the attachment formats haven't changed.
+
+        // Keys are prefixed with their length so that neighbouring variable-length keys can't run together.
+        auto appendHandleOrKey = [&key](const std::string& handleKey, auto handle) {
+            Utils::AppendKey(key, handleKey.size());
+
+            if (handleKey.empty()) Utils::AppendKey(key, handle);
+            else key += handleKey;
+        };
+
+        appendHandleOrKey(configInfo.layoutKey, configInfo.pipelineLayout);
+        appendHandleOrKey(configInfo.renderPassKey, configInfo.renderPass);
+
+        Utils::AppendKey(key, configInfo.subPass);
+
+        return key;
+    }
+}
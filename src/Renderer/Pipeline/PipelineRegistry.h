@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../Core.h"
+#include "Pipeline.h"
+
+#include <unordered_map>
+#include <future>
+#include <mutex>
+#include <string>
+
+namespace SnekVk
+{
+    /**
+     * @brief The PipelineRegistry stores every graphics pipeline created by the renderer. Pipelines are
+     * keyed by their full description: shader modules, vertex input, fixed-function state, layout
+     * compatibility and render pass compatibility. Requesting a pipeline with a description that already
+     * exists returns the existing VkPipeline rather than compiling a new one.
+     *
+     * Pipelines are reference counted. Every call to Acquire() must be matched by a call to Release(). The
+     * registry is thread-safe. If two threads request the same description at once, only one compiles the
+     * pipeline while the other waits for the result.
+     */
+    class PipelineRegistry
+    {
+        public:
+
+        /**
+         * @brief Returns a pipeline matching the provided description, compiling one if none exists.
+         *
+         * @param configInfo the fixed-function configuration for the pipeline.
+         * @param modules the shader modules used by the pipeline.
+         * @param stages the stage of each shader module.
+         * @param shaderCount the number of shader modules.
+         * @return VkPipeline the pipeline matching the description.
+         */
+        static VkPipeline Acquire(
+            const PipelineConfigInfo& configInfo,
+            const VkShaderModule* modules,
+            const PipelineConfig::PipelineStage* stages,
+            u32 shaderCount
+        );
+
+        /**
+         * @brief Decrements the reference count of a pipeline. The pipeline is destroyed once it is
+         * no longer referenced.
+         *
+         * @param pipeline the pipeline returned by Acquire().
+         */
+        static void Release(VkPipeline pipeline);
+
+        /**
+         * @brief Adds a reference to a pipeline layout. A shared pipeline may outlive the material whose
+         * layout it was compiled with, so layouts are reference counted by their owners and by every
+         * pipeline compiled with them. Layouts are destroyed by the registry once no references remain.
+         *
+         * @param layout the layout being referenced.
+         */
+        static void RetainLayout(VkPipelineLayout layout);
+
+        /**
+         * @brief Removes a reference to a pipeline layout. The layout is queued for deletion once it is
+         * no longer referenced.
+         *
+         * @param layout the layout being released.
+         */
+        static void ReleaseLayout(VkPipelineLayout layout);
+
+        /**
+         * @brief Destroys all pipelines held by the registry, regardless of their reference count.
+         * Should only be called when the renderer is being destroyed.
+         */
+        static void DestroyRegistry();
+
+        /**
+         * @brief Returns the number of unique pipelines currently alive.
+         */
+        static size_t GetPipelineCount();
+
+        private:
+
+        struct Entry
+        {
+            std::shared_future<VkPipeline> pipeline;
+            // The layout the pipeline was compiled with, which must outlive it.
+            VkPipelineLayout layout {VK_NULL_HANDLE};
+            u32 refCount = 0;
+        };
+
+        // Must be called with the registry locked.
+        static void DecrementLayout(VkPipelineLayout layout);
+
+        static std::string CreateKey(
+            const PipelineConfigInfo& configInfo,
+            const VkShaderModule* modules,
+            const PipelineConfig::PipelineStage* stages,
+            u32 shaderCount
+        );
+
+        // Maps a pipeline's description to the pipeline compiled from it.
+        static std::unordered_map<std::string, Entry> pipelines;
+
+        // Maps each compiled pipeline back to its description. Keys point into the pipelines map,
+        // whose elements never move.
+        static std::unordered_map<VkPipeline, const std::string*> pipelineKeys;
+
+        static std::unordered_map<VkPipelineLayout, u32> layoutReferences;
+
+        static std::mutex registryMutex;
+    };
+}
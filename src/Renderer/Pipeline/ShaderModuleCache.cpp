@@ -0,0 +1,143 @@
+#include "ShaderModuleCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace SnekVk
+{
+    std::unordered_map<std::string, VkShaderModule> ShaderModuleCache::pathModules;
+    std::unordered_multimap<size_t, VkShaderModule> ShaderModuleCache::contentModules;
+    std::unordered_map<VkShaderModule, ShaderModuleCache::Entry> ShaderModuleCache::modules;
+    std::mutex ShaderModuleCache::cacheMutex;
+
+    VkShaderModule ShaderModuleCache::Acquire(const char* filePath)
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        std::string path(filePath);
+
+        // If we've seen this path before then we can skip the disk entirely.
+        auto pathIt = pathModules.find(path);
+        if (pathIt != pathModules.end())
+        {
+            modules[pathIt->second].refCount++;
+            return pathIt->second;
+        }
+
+        auto shaderCode = ReadFile(filePath);
+
+        size_t contentHash = static_cast<size_t>(Utils::Hash64(shaderCode.Data(), shaderCode.Size()));
+
+        // A different path may have already loaded the same binary.
+        auto range = contentModules.equal_range(contentHash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            auto& entry = modules[it->second];
+
+            if (entry.code.size() != shaderCode.Size() ||
+                std::memcmp(entry.code.data(), shaderCode.Data(), shaderCode.Size()) != 0) continue;
+
+            entry.paths.push_back(path);
+            entry.refCount++;
+            pathModules[path] = it->second;
+
+            return it->second;
+        }
+
+        VkShaderModule module = CreateShaderModule(shaderCode);
+
+        auto& entry = modules[module];
+        entry.contentHash = contentHash;
+        entry.code.assign(shaderCode.Data(), shaderCode.Data() + shaderCode.Size());
+        entry.paths.push_back(path);
+        entry.refCount = 1;
+
+        contentModules.emplace(contentHash, module);
+        pathModules[path] = module;
+
+        return module;
+    }
+
+    void ShaderModuleCache::Release(VkShaderModule module)
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        auto it = modules.find(module);
+
+        if (it == modules.end()) return;
+
+        auto& entry = it->second;
+
+        if (--entry.refCount > 0) return;
+
+        vkDestroyShaderModule(VulkanDevice::GetDeviceInstance()->Device(), module, nullptr);
+
+        for (auto& path : entry.paths) pathModules.erase(path);
+
+        auto range = contentModules.equal_range(entry.contentHash);
+        for (auto contentIt = range.first; contentIt != range.second; contentIt++)
+        {
+            if (contentIt->second != module) continue;
+
+            contentModules.erase(contentIt);
+            break;
+        }
+
+        modules.erase(it);
+    }
+
+    void ShaderModuleCache::DestroyCache()
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        auto device = VulkanDevice::GetDeviceInstance();
+
+        for (auto& module : modules) vkDestroyShaderModule(device->Device(), module.first, nullptr);
+
+        modules.clear();
+        contentModules.clear();
+        pathModules.clear();
+    }
+
+    Utils::Array<char> ShaderModuleCache::ReadFile(const char* filePath)
+    {
+        // Read the file as binary and consume the entire file.
+        std::ifstream file { filePath, std::ios::ate | std::ios::binary };
+
+        SNEK_ASSERT(file.is_open(), std::string("Could not find file: ") + filePath);
+
+        // Since we consumed the entire file, we can tell the size by checking where
+        // the file stream is reading from (which presumably is at the end of the file).
+        u32 size = static_cast<u32>(file.tellg());
+
+        Utils::Array<char> buffer(size);
+
+        // Move to the beginning of the file.
+        file.seekg(0);
+
+        file.read(buffer.Data(), size);
+
+        file.close();
+
+        return buffer;
+    }
+
+    VkShaderModule ShaderModuleCache::CreateShaderModule(Utils::Array<char>& fileData)
+    {
+        VkShaderModuleCreateInfo createInfo {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = fileData.Size();
+        // Because the code is expected to be numerical, we need to cast the values in the
+        // array to 32-bit unsigned integers.
+        createInfo.pCode = reinterpret_cast<const u32*>(fileData.Data());
+
+        auto device = VulkanDevice::GetDeviceInstance();
+
+        VkShaderModule shaderModule {VK_NULL_HANDLE};
+
+        SNEK_ASSERT(vkCreateShaderModule(device->Device(), &createInfo, nullptr, OUT &shaderModule) == VK_SUCCESS,
+            "Failed to create shader module!");
+
+        return shaderModule;
+    }
+}
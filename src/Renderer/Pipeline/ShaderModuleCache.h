@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Device/VulkanDevice.h"
+
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SnekVk
+{
+    /**
+     * @brief The ShaderModuleCache stores all shader modules created by the renderer. Shader files are
+     * only read from disk the first time their path is requested. Modules are looked up by the hash of their
+     * SPIR-V contents and then compared byte for byte, meaning that two paths containing identical binaries
+     * will share the same module.
+     *
+     * Modules are reference counted. Every call to Acquire() must be matched by a call to Release(). A module
+     * is destroyed once no pipelines reference it anymore. The cache is thread-safe, allowing pipelines to be
+     * compiled on worker threads.
+     */
+    class ShaderModuleCache
+    {
+        public:
+
+        /**
+         * @brief Returns a shader module for the provided SPIR-V file. If the file has been loaded before then
+         * the existing module is returned and its reference count is incremented.
+         *
+         * @param filePath the path to a SPIR-V shader binary.
+         * @return VkShaderModule the shader module holding the shader's contents.
+         */
+        static VkShaderModule Acquire(const char* filePath);
+
+        /**
+         * @brief Decrements the reference count of a shader module. The module is destroyed once
+         * it is no longer referenced.
+         *
+         * @param module the module being released.
+         */
+        static void Release(VkShaderModule module);
+
+        /**
+         * @brief Destroys all shader modules held by the cache, regardless of their reference count.
+         * Should only be called when the renderer is being destroyed.
+         */
+        static void DestroyCache();
+
+        private:
+
+        struct Entry
+        {
+            size_t contentHash {0};
+            std::vector<char> code;
+            // Every path which has resolved to this module.
+            std::vector<std::string> paths;
+            u32 refCount = 0;
+        };
+
+        /**
+         * Reads a file and returns the contents in binary. This is particularly
+         * useful for binary shader file formats (like spir-v).
+         * @param filePath a raw c string specifying the file path.
+         * @returns a heap-allocated array containing the file contents.
+         **/
+        static Utils::Array<char> ReadFile(const char* filePath);
+
+        /**
+         * Converts the binary shader into a vulkan shader module.
+         * A shader module is an interface for our pipelines to actually
+         * receive shader data.
+         * @param fileData an array containing our binary shader data.
+         * @returns the created shader module.
+         **/
+        static VkShaderModule CreateShaderModule(Utils::Array<char>& fileData);
+
+        // Maps a shader's path to the module created from it. Keyed by the full path, since interned
+        // ids may collide.
+        static std::unordered_map<std::string, VkShaderModule> pathModules;
+
+        // Maps a content hash to every module with that hash. Collisions are resolved by comparing code.
+        static std::unordered_multimap<size_t, VkShaderModule> contentModules;
+
+        static std::unordered_map<VkShaderModule, Entry> modules;
+
+        static std::mutex cacheMutex;
+    };
+}
@@ -0,0 +1,162 @@
+#include "CpuProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace SnekVk
+{
+    std::vector<std::unique_ptr<CpuProfiler::ThreadBuffer>> CpuProfiler::buffers;
+    std::vector<CpuProfiler::ThreadBuffer*> CpuProfiler::freeBuffers;
+    std::mutex CpuProfiler::buffersMutex;
+    std::atomic<bool> CpuProfiler::isEnabled {true};
+
+    CpuProfiler::ThreadBuffer* CpuProfiler::GetThreadBuffer()
+    {
+        // Hands the buffer back when the thread exits, so short-lived threads (such as pipeline
+        // compilation tasks) don't each keep a ring alive.
+        struct ThreadBufferOwner
+        {
+            ThreadBuffer* buffer {nullptr};
+
+            ~ThreadBufferOwner()
+            {
+                if (buffer) ReleaseThreadBuffer(buffer);
+            }
+        };
+
+        static thread_local ThreadBufferOwner owner;
+
+        if (owner.buffer) return owner.buffer;
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        if (!freeBuffers.empty())
+        {
+            owner.buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+            return owner.buffer;
+        }
+
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        owner.buffer = buffers.back().get();
+        owner.buffer->threadId = static_cast<u32>(buffers.size() - 1);
+
+        return owner.buffer;
+    }
+
+    void CpuProfiler::ReleaseThreadBuffer(ThreadBuffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        freeBuffers.push_back(buffer);
+    }
+
+    void CpuProfiler::Record(const char* name, u64 start, u64 end)
+    {
+        auto buffer = GetThreadBuffer();
+
+        u64 count = buffer->count.load(std::memory_order_relaxed);
+
+        // Keeps the slot's write from becoming visible before the previous event was published, so
+        // readers can tell when a slot is being overwritten.
+        std::atomic_thread_fence(std::memory_order_release);
+
+        buffer->events[count & (RING_SIZE - 1)] = { name, start, end };
+
+        // Publish the event only once it's been fully written.
+        buffer->count.store(count + 1, std::memory_order_release);
+    }
+
+    void CpuProfiler::CopyEvents(const ThreadBuffer& buffer, OUT std::vector<Event>& events)
+    {
+        u64 count = buffer.count.load(std::memory_order_acquire);
+        u64 first = count > RING_SIZE ? count - RING_SIZE : 0;
+
+        events.clear();
+        events.reserve(static_cast<size_t>(count - first));
+
+        for (u64 i = first; i < count; i++) events.push_back(buffer.events[i & (RING_SIZE - 1)]);
+
+        // The owning thread may have kept writing while we copied. Its next write goes to index
+        // 'latest', which reuses the slot of index 'latest - RING_SIZE', so every event at or below
+        // that index may have been torn and is discarded.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        u64 latest = buffer.count.load(std::memory_order_relaxed);
+
+        u64 firstValid = latest + 1 > RING_SIZE ? latest + 1 - RING_SIZE : 0;
+
+        if (firstValid <= first) return;
+
+        size_t discarded = static_cast<size_t>(std::min(firstValid - first, count - first));
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(discarded));
+    }
+
+    bool CpuProfiler::WriteChromeTrace(const char* filePath)
+    {
+        std::ofstream file(filePath, std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            SNEK_LOG_ERROR("Failed to open trace file: " << filePath);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        // Every ring is copied first so that timestamps are only ever taken from validated events.
+        std::vector<std::vector<Event>> threadEvents(buffers.size());
+
+        for (size_t i = 0; i < buffers.size(); i++) CopyEvents(*buffers[i], threadEvents[i]);
+
+        // Timestamps are written relative to the earliest recorded event.
+        u64 origin = std::numeric_limits<u64>::max();
+
+        for (auto& events : threadEvents)
+        {
+            for (auto& event : events) origin = std::min(origin, event.start);
+        }
+
+        // Write timestamps with a fixed nanosecond fraction, so long traces don't lose precision.
+        file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+        bool isFirst = true;
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            for (auto& event : threadEvents[i])
+            {
+                if (!isFirst) file << ",";
+                isFirst = false;
+
+                file << "\n{\"name\":\"";
+
+                for (const char* c = event.name; *c; c++)
+                {
+                    if (*c == '"' || *c == '\\') file << '\\';
+                    file << *c;
+                }
+
+                // Chrome traces are measured in microseconds.
+                file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffers[i]->threadId
+                     << ",\"ts\":" << static_cast<double>(event.start - origin) / 1000.0
+                     << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << "}";
+            }
+        }
+
+        file << "\n]}\n";
+
+        SNEK_LOG_INFO("Wrote CPU trace to: " << filePath);
+
+        return true;
+    }
+
+    void CpuProfiler::Clear()
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        // Buffers may still be in use by their threads, so only their contents can be discarded.
+        for (auto& buffer : buffers) buffer->count.store(0, std::memory_order_relaxed);
+    }
+}
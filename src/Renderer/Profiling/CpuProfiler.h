@@ -0,0 +1,148 @@
+#pragma once
+
+#include "../Core.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define CPU_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CPU_PROFILE_CONCAT(a, b) CPU_PROFILE_CONCAT_IMPL(a, b)
+
+// Defining SNEK_DISABLE_PROFILING compiles all markers out entirely.
+#ifdef SNEK_DISABLE_PROFILING
+#define CPU_PROFILE_SCOPE(name)
+#define CPU_PROFILE_FUNCTION()
+#else
+// Records the time spent between this point and the end of the current scope.
+#define CPU_PROFILE_SCOPE(name) \
+    SnekVk::CpuProfiler::Scope CPU_PROFILE_CONCAT(cpuScope, __LINE__)(name)
+#define CPU_PROFILE_FUNCTION() CPU_PROFILE_SCOPE(__func__)
+#endif
+
+namespace SnekVk
+{
+    /**
+     * @brief The CpuProfiler records named, scoped markers on any thread. Each thread writes into its own
+     * ring buffer, so recording a marker never takes a lock or allocates - it costs two clock reads and a
+     * single store. Once a ring is full the oldest markers are overwritten.
+     *
+     * Recorded markers can be written out as a Chrome trace (viewable in chrome://tracing or Perfetto).
+     */
+    class CpuProfiler
+    {
+        public:
+
+        // Must be a power of two.
+        static constexpr u32 RING_SIZE = 16384;
+
+        /**
+         * @brief Records a marker spanning its own lifetime.
+         */
+        class Scope
+        {
+            public:
+
+            Scope(const char* name) : name{isEnabled.load(std::memory_order_relaxed) ? name : nullptr}
+            {
+                if (this->name) start = Now();
+            }
+
+            ~Scope()
+            {
+                if (name) Record(name, start, Now());
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            private:
+
+            const char* name;
+            u64 start {0};
+        };
+
+        /**
+         * @brief Enables or disables recording. Markers which are already open when this is called are
+         * unaffected.
+         */
+        static void SetEnabled(bool enabled) { isEnabled.store(enabled, std::memory_order_relaxed); }
+
+        static bool IsEnabled() { return isEnabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Records a completed marker on the calling thread.
+         *
+         * @param name the name of the marker. Must outlive the profiler (typically a string literal).
+         * @param start the time the marker began, as returned by Now().
+         * @param end the time the marker ended, as returned by Now().
+         */
+        static void Record(const char* name, u64 start, u64 end);
+
+        /**
+         * @brief Writes every recorded marker to a Chrome trace JSON file. This may run while other threads
+         * are recording: each ring is copied and any slot which its thread overwrote during the copy is
+         * dropped, so markers recorded during the export may be missing but are never torn.
+         *
+         * @param filePath the path of the file to write.
+         * @return true if the file was written.
+         */
+        static bool WriteChromeTrace(const char* filePath);
+
+        /**
+         * @brief Discards all recorded markers. Should only be called while no other thread is recording.
+         */
+        static void Clear();
+
+        /**
+         * @brief Returns the current time in nanoseconds.
+         */
+        static u64 Now()
+        {
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        private:
+
+        struct Event
+        {
+            const char* name {nullptr};
+            u64 start = 0;
+            u64 end = 0;
+        };
+
+        struct ThreadBuffer
+        {
+            Event events[RING_SIZE];
+            // The total number of events written. Only the owning thread writes to it.
+            std::atomic<u64> count {0};
+            u32 threadId = 0;
+        };
+
+        /**
+         * @brief Returns the calling thread's buffer, registering one on first use. Buffers outlive their
+         * threads so that their markers can still be exported, and are handed to new threads once their
+         * owners exit. Threads which re-use a buffer also take over its thread id.
+         */
+        static ThreadBuffer* GetThreadBuffer();
+
+        /**
+         * @brief Returns an exited thread's buffer to the free list.
+         */
+        static void ReleaseThreadBuffer(ThreadBuffer* buffer);
+
+        /**
+         * @brief Copies a buffer's published events, oldest first, skipping any which its thread may have
+         * overwritten while they were being copied.
+         */
+        static void CopyEvents(const ThreadBuffer& buffer, OUT std::vector<Event>& events);
+
+        static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        static std::vector<ThreadBuffer*> freeBuffers;
+        static std::mutex buffersMutex;
+        static std::atomic<bool> isEnabled;
+    };
+}
@@ -0,0 +1,319 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+
+namespace SnekVk
+{
+    GpuProfiler::FrameQueries GpuProfiler::frames[SwapChain::MAX_FRAMES_IN_FLIGHT];
+    u32 GpuProfiler::currentFrame = 0;
+
+    std::unordered_map<Utils::StringId, GpuProfiler::ScopeHistory> GpuProfiler::histories;
+
+    bool GpuProfiler::isTimestampSupported = false;
+    bool GpuProfiler::isStatisticsSupported = false;
+    bool GpuProfiler::isStatisticsActive = false;
+    float GpuProfiler::timestampPeriod = 0.f;
+    u64 GpuProfiler::timestampMask = 0;
+
+    // The order in which the counters are written matches the order of their bits.
+    static constexpr VkQueryPipelineStatisticFlags STATISTIC_FLAGS = 
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+    static constexpr u32 STATISTIC_COUNT = 6;
+
+    GpuProfiler::Scope::Scope(VkCommandBuffer commandBuffer, const char* name)
+        : commandBuffer{commandBuffer}, scope{BeginScope(commandBuffer, name)}
+    {}
+
+    GpuProfiler::Scope::~Scope()
+    {
+        EndScope(commandBuffer, scope);
+    }
+
+    void GpuProfiler::Initialise()
+    {
+        auto device = VulkanDevice::GetDeviceInstance();
+
+        // Timestamps are only valid on queues which report a non-zero number of valid bits.
+        auto indices = device->FindPhysicalQueueFamilies();
+
+        u32 queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device->PhysicalDevice(), OUT &queueFamilyCount, nullptr);
+
+        VkQueueFamilyProperties queueFamilies[queueFamilyCount];
+        vkGetPhysicalDeviceQueueFamilyProperties(device->PhysicalDevice(), &queueFamilyCount, OUT queueFamilies);
+
+        u32 validBits = queueFamilies[indices.graphicsFamily].timestampValidBits;
+
+        isTimestampSupported = validBits > 0 && device->properties.limits.timestampPeriod > 0.f;
+        isStatisticsSupported = device->enabledFeatures.pipelineStatisticsQuery == VK_TRUE;
+
+        if (!isTimestampSupported) SNEK_LOG_WARNING("GPU timestamps are not supported, GPU timings are disabled");
+        if (!isStatisticsSupported) SNEK_LOG_WARNING("Pipeline statistics are not supported, GPU statistics are disabled");
+
+        if (isTimestampSupported)
+        {
+            timestampPeriod = device->properties.limits.timestampPeriod;
+            timestampMask = validBits == 64 ? ~0ull : (1ull << validBits) - 1;
+
+            VkQueryPoolCreateInfo poolInfo {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            // Every scope needs a query for its beginning and end.
+            poolInfo.queryCount = MAX_SCOPES * 2;
+
+            for (auto& frame : frames)
+            {
+                SNEK_ASSERT(vkCreateQueryPool(device->Device(), &poolInfo, nullptr, OUT &frame.timestampPool) == VK_SUCCESS,
+                    "Failed to create timestamp query pool!");
+            }
+        }
+
+        if (isStatisticsSupported)
+        {
+            VkQueryPoolCreateInfo poolInfo {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            poolInfo.queryCount = MAX_SCOPES;
+            poolInfo.pipelineStatistics = STATISTIC_FLAGS;
+
+            for (auto& frame : frames)
+            {
+                SNEK_ASSERT(vkCreateQueryPool(device->Device(), &poolInfo, nullptr, OUT &frame.statisticsPool) == VK_SUCCESS,
+                    "Failed to create pipeline statistics query pool!");
+            }
+        }
+
+        for (auto& frame : frames) frame.scopeCount = 0;
+    }
+
+    void GpuProfiler::Destroy()
+    {
+        auto device = VulkanDevice::GetDeviceInstance();
+
+        for (auto& frame : frames)
+        {
+            if (frame.timestampPool != VK_NULL_HANDLE) vkDestroyQueryPool(device->Device(), frame.timestampPool, nullptr);
+            if (frame.statisticsPool != VK_NULL_HANDLE) vkDestroyQueryPool(device->Device(), frame.statisticsPool, nullptr);
+            frame.timestampPool = VK_NULL_HANDLE;
+            frame.statisticsPool = VK_NULL_HANDLE;
+            frame.scopeCount = 0;
+        }
+
+        histories.clear();
+        isTimestampSupported = false;
+        isStatisticsSupported = false;
+        isStatisticsActive = false;
+    }
+
+    void GpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, u32 frameIndex)
+    {
+        if (!IsSupported()) return;
+
+        currentFrame = frameIndex;
+        isStatisticsActive = false;
+
+        auto& frame = frames[frameIndex];
+
+        if (isTimestampSupported)
+        {
+            ReadTimestamps(frame);
+            vkCmdResetQueryPool(commandBuffer, frame.timestampPool, 0, MAX_SCOPES * 2);
+        }
+
+        if (isStatisticsSupported)
+        {
+            ReadStatistics(frame);
+            vkCmdResetQueryPool(commandBuffer, frame.statisticsPool, 0, MAX_SCOPES);
+        }
+
+        frame.scopeCount = 0;
+    }
+
+    i32 GpuProfiler::BeginScope(VkCommandBuffer commandBuffer, const char* name)
+    {
+        if (!IsSupported()) return -1;
+
+        auto& frame = frames[currentFrame];
+
+        if (frame.scopeCount >= MAX_SCOPES) return -1;
+
+        auto id = Utils::WSID(name);
+
+        auto& history = histories[id];
+        history.name = name;
+
+        u32 scope = frame.scopeCount;
+        frame.scopes[scope] = id;
+        frame.scopeHasStatistics[scope] = isStatisticsSupported && !isStatisticsActive;
+        frame.scopeCount++;
+
+        if (isTimestampSupported)
+        {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool, scope * 2);
+        }
+
+        if (frame.scopeHasStatistics[scope])
+        {
+            vkCmdBeginQuery(commandBuffer, frame.statisticsPool, scope, 0);
+            isStatisticsActive = true;
+        }
+
+        return static_cast<i32>(scope);
+    }
+
+    void GpuProfiler::EndScope(VkCommandBuffer commandBuffer, i32 scope)
+    {
+        if (scope < 0) return;
+
+        auto& frame = frames[currentFrame];
+
+        if (frame.scopeHasStatistics[scope])
+        {
+            vkCmdEndQuery(commandBuffer, frame.statisticsPool, scope);
+            isStatisticsActive = false;
+        }
+
+        if (isTimestampSupported)
+        {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.timestampPool, scope * 2 + 1);
+        }
+    }
+
+    void GpuProfiler::ReadTimestamps(FrameQueries& frame)
+    {
+        if (frame.scopeCount == 0) return;
+
+        u32 queryCount = frame.scopeCount * 2;
+
+        // Each query is followed by its availability.
+        u64 results[MAX_SCOPES * 2 * 2];
+
+        // The frame's fence has signalled, so results should be ready. We never wait on them though,
+        // so any queries which aren't available are skipped rather than stalling.
+        vkGetQueryPoolResults(
+            VulkanDevice::GetDeviceInstance()->Device(),
+            frame.timestampPool,
+            0,
+            queryCount,
+            sizeof(results),
+            OUT results,
+            sizeof(u64) * 2,
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        for (u32 i = 0; i < frame.scopeCount; i++)
+        {
+            u64* begin = &results[i * 4];
+            u64* end = &results[i * 4 + 2];
+
+            if (begin[1] == 0 || end[1] == 0) continue;
+
+            u64 ticks = ((end[0] & timestampMask) - (begin[0] & timestampMask)) & timestampMask;
+
+            float milliseconds = static_cast<float>(ticks) * timestampPeriod / 1000000.f;
+
+            auto& history = histories[frame.scopes[i]];
+
+            history.samples[history.nextSample] = milliseconds;
+            history.nextSample = (history.nextSample + 1) % SAMPLE_COUNT;
+            history.sampleCount = std::min(history.sampleCount + 1, SAMPLE_COUNT);
+        }
+    }
+
+    void GpuProfiler::ReadStatistics(FrameQueries& frame)
+    {
+        if (frame.scopeCount == 0) return;
+
+        // Each query writes all of its counters followed by its availability.
+        constexpr u32 stride = STATISTIC_COUNT + 1;
+
+        u64 results[MAX_SCOPES * stride];
+
+        // Scopes without statistics were never begun, so they'll simply report as unavailable.
+        vkGetQueryPoolResults(
+            VulkanDevice::GetDeviceInstance()->Device(),
+            frame.statisticsPool,
+            0,
+            frame.scopeCount,
+            sizeof(results),
+            OUT results,
+            sizeof(u64) * stride,
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        for (u32 i = 0; i < frame.scopeCount; i++)
+        {
+            if (!frame.scopeHasStatistics[i]) continue;
+
+            u64* counters = &results[i * stride];
+
+            if (counters[STATISTIC_COUNT] == 0) continue;
+
+            auto& history = histories[frame.scopes[i]];
+
+            history.statistics.inputAssemblyVertices = counters[0];
+            history.statistics.inputAssemblyPrimitives = counters[1];
+            history.statistics.vertexShaderInvocations = counters[2];
+            history.statistics.clippingInvocations = counters[3];
+            history.statistics.clippingPrimitives = counters[4];
+            history.statistics.fragmentShaderInvocations = counters[5];
+            history.hasStatistics = true;
+        }
+    }
+
+    GpuProfiler::Stats GpuProfiler::GetStats(const char* name)
+    {
+        Stats stats;
+
+        auto it = histories.find(Utils::WSID(name));
+
+        if (it == histories.end()) return stats;
+
+        auto& history = it->second;
+
+        stats.pipelineStatistics = history.statistics;
+        stats.hasPipelineStatistics = history.hasStatistics;
+
+        if (history.sampleCount == 0) return stats;
+
+        float sorted[SAMPLE_COUNT];
+        std::copy(history.samples, history.samples + history.sampleCount, sorted);
+        std::sort(sorted, sorted + history.sampleCount);
+
+        float total = 0.f;
+        for (u32 i = 0; i < history.sampleCount; i++) total += sorted[i];
+
+        stats.min = sorted[0];
+        stats.average = total / static_cast<float>(history.sampleCount);
+        stats.p99 = sorted[(history.sampleCount - 1) * 99 / 100];
+        stats.sampleCount = history.sampleCount;
+
+        return stats;
+    }
+
+    void GpuProfiler::ClearHistory()
+    {
+        // Entries are kept so that their names remain valid.
+        for (auto& entry : histories)
+        {
+            auto& history = entry.second;
+            history.sampleCount = 0;
+            history.nextSample = 0;
+            history.hasStatistics = false;
+        }
+    }
+
+    std::vector<const char*> GpuProfiler::GetScopeNames()
+    {
+        std::vector<const char*> names;
+        names.reserve(histories.size());
+
+        for (auto& history : histories) names.push_back(history.second.name);
+
+        return names;
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../Core.h"
+#include "../Device/VulkanDevice.h"
+#include "../Swapchain/Swapchain.h"
+
+#include <unordered_map>
+#include <vector>
+
+#define GPU_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b) GPU_PROFILE_CONCAT_IMPL(a, b)
+
+// Times (and counts pipeline statistics for) the GPU work recorded between this point and the end of the current scope.
+#define GPU_PROFILE_SCOPE(commandBuffer, name) \
+    SnekVk::GpuProfiler::Scope GPU_PROFILE_CONCAT(gpuScope, __LINE__)(commandBuffer, name)
+
+namespace SnekVk
+{
+    /**
+     * @brief The GpuProfiler measures how long the GPU spends executing sections of a frame. Scopes write a
+     * timestamp when they begin and end. Each frame in flight owns its own query pool, so results are read
+     * back once that frame's fence has been waited on (when the frame is next started), without ever waiting
+     * on the GPU.
+     *
+     * Timings are kept in a rolling window per scope, from which the min, average and 99th percentile can
+     * be queried. 
+     *
+     * Where the device supports pipeline statistics queries, each scope also counts the vertices, primitives
+     * and shader invocations it produced. Only one statistics query can be active at a time, so scopes nested
+     * inside another scope are only timed. Devices without timestamps or statistics simply skip them.
+     */
+    class GpuProfiler
+    {
+        public:
+
+        static constexpr u32 MAX_SCOPES = 64;
+        static constexpr u32 SAMPLE_COUNT = 240;
+
+        struct PipelineStatistics
+        {
+            u64 inputAssemblyVertices = 0;
+            u64 inputAssemblyPrimitives = 0;
+            u64 vertexShaderInvocations = 0;
+            u64 clippingInvocations = 0;
+            u64 clippingPrimitives = 0;
+            u64 fragmentShaderInvocations = 0;
+        };
+
+        struct Stats
+        {
+            // All timings are in milliseconds.
+            float min = 0.f;
+            float average = 0.f;
+            float p99 = 0.f;
+            u32 sampleCount = 0;
+
+            // The counters from the most recently completed frame. Only valid if hasPipelineStatistics is set.
+            PipelineStatistics pipelineStatistics;
+            bool hasPipelineStatistics = false;
+        };
+
+        /**
+         * @brief Begins a scope on construction and ends it on destruction.
+         */
+        class Scope
+        {
+            public:
+
+            Scope(VkCommandBuffer commandBuffer, const char* name);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            private:
+
+            VkCommandBuffer commandBuffer;
+            i32 scope;
+        };
+
+        /**
+         * @brief Creates the query pools for each frame in flight.
+         */
+        static void Initialise();
+
+        static void Destroy();
+
+        /**
+         * @brief Reads back the results of the last frame recorded with this index, then resets its queries.
+         * Must be called after the frame's fence has been waited on, outside of a render pass.
+         *
+         * @param commandBuffer the frame's command buffer, which must be recording.
+         * @param frameIndex the index of the frame in flight.
+         */
+        static void BeginFrame(VkCommandBuffer commandBuffer, u32 frameIndex);
+
+        /**
+         * @brief Writes the starting timestamp of a scope and begins its statistics query.
+         *
+         * @param commandBuffer the command buffer being recorded.
+         * @param name the name of the scope. Must outlive the profiler (typically a string literal).
+         * @return i32 the index of the scope, or -1 if the scope couldn't be recorded.
+         */
+        static i32 BeginScope(VkCommandBuffer commandBuffer, const char* name);
+
+        /**
+         * @brief Writes the ending timestamp of a scope and ends its statistics query. Scopes which were
+         * begun inside a render pass must be ended in the same subpass.
+         *
+         * @param commandBuffer the command buffer being recorded.
+         * @param scope the index returned by BeginScope().
+         */
+        static void EndScope(VkCommandBuffer commandBuffer, i32 scope);
+
+        /**
+         * @brief Returns the rolling statistics for a scope.
+         */
+        static Stats GetStats(const char* name);
+
+        /**
+         * @brief Discards every recorded sample, so that statistics only reflect frames recorded from now on.
+         */
+        static void ClearHistory();
+
+        /**
+         * @brief Returns the names of every scope that has been recorded.
+         */
+        static std::vector<const char*> GetScopeNames();
+
+        static bool IsSupported() { return isTimestampSupported || isStatisticsSupported; }
+        static bool IsTimestampSupported() { return isTimestampSupported; }
+        static bool IsPipelineStatisticsSupported() { return isStatisticsSupported; }
+
+        private:
+
+        struct ScopeHistory
+        {
+            const char* name {nullptr};
+            float samples[SAMPLE_COUNT] {0.f};
+            u32 sampleCount = 0;
+            u32 nextSample = 0;
+            PipelineStatistics statistics;
+            bool hasStatistics = false;
+        };
+
+        struct FrameQueries
+        {
+            VkQueryPool timestampPool {VK_NULL_HANDLE};
+            VkQueryPool statisticsPool {VK_NULL_HANDLE};
+            Utils::StringId scopes[MAX_SCOPES];
+            bool scopeHasStatistics[MAX_SCOPES] {false};
+            u32 scopeCount = 0;
+        };
+
+        static void ReadTimestamps(FrameQueries& frame);
+        static void ReadStatistics(FrameQueries& frame);
+
+        static FrameQueries frames[SwapChain::MAX_FRAMES_IN_FLIGHT];
+        static u32 currentFrame;
+
+        static std::unordered_map<Utils::StringId, ScopeHistory> histories;
+
+        static bool isTimestampSupported;
+        static bool isStatisticsSupported;
+        // Statistics queries can't be nested, so only the outermost scope records them.
+        static bool isStatisticsActive;
+        static float timestampPeriod;
+        static u64 timestampMask;
+    };
+}
@@ -0,0 +1,102 @@
+#include "RenderStatistics.h"
+
+namespace SnekVk
+{
+    std::atomic<u64> RenderStatistics::counters[COUNTER_COUNT];
+
+    RendererStats RenderStatistics::lastFrame;
+    u64 RenderStatistics::frameCount = 0;
+
+    std::ofstream RenderStatistics::dumpFile;
+    RenderStatistics::DumpFormat RenderStatistics::dumpFormat = RenderStatistics::CSV;
+    bool RenderStatistics::isFirstRow = true;
+
+    void RenderStatistics::EndFrame()
+    {
+        u64 values[COUNTER_COUNT];
+
+        for (u32 i = 0; i < COUNTER_COUNT; i++) values[i] = counters[i].exchange(0, std::memory_order_relaxed);
+
+        lastFrame.frame = frameCount++;
+        lastFrame.drawCalls = values[DRAW_CALLS];
+        lastFrame.verticesDrawn = values[VERTICES_DRAWN];
+        lastFrame.pipelineBinds = values[PIPELINE_BINDS];
+        lastFrame.descriptorSetBinds = values[DESCRIPTOR_SET_BINDS];
+        lastFrame.vertexBufferBinds = values[VERTEX_BUFFER_BINDS];
+        lastFrame.indexBufferBinds = values[INDEX_BUFFER_BINDS];
+        lastFrame.bufferUploads = values[BUFFER_UPLOADS];
+        lastFrame.bytesUploaded = values[BYTES_UPLOADED];
+        lastFrame.stagingCopies = values[STAGING_COPIES];
+        lastFrame.singleTimeSubmits = values[SINGLE_TIME_SUBMITS];
+
+        if (dumpFile.is_open()) WriteRow(lastFrame);
+    }
+
+    bool RenderStatistics::StartDump(const char* filePath, DumpFormat format)
+    {
+        StopDump();
+
+        dumpFile.open(filePath, std::ios::trunc);
+
+        if (!dumpFile.is_open())
+        {
+            SNEK_LOG_ERROR("Failed to open statistics file: " << filePath);
+            return false;
+        }
+
+        dumpFormat = format;
+        isFirstRow = true;
+
+        if (dumpFormat == CSV)
+        {
+            dumpFile << "frame,drawCalls,verticesDrawn,pipelineBinds,descriptorSetBinds,vertexBufferBinds,"
+                     << "indexBufferBinds,bufferUploads,bytesUploaded,stagingCopies,singleTimeSubmits\n";
+        }
+        else dumpFile << "[";
+
+        return true;
+    }
+
+    void RenderStatistics::StopDump()
+    {
+        if (!dumpFile.is_open()) return;
+
+        if (dumpFormat == JSON) dumpFile << "\n]\n";
+
+        dumpFile.close();
+    }
+
+    void RenderStatistics::WriteRow(const RendererStats& stats)
+    {
+        if (dumpFormat == CSV)
+        {
+            dumpFile << stats.frame << ","
+                     << stats.drawCalls << ","
+                     << stats.verticesDrawn << ","
+                     << stats.pipelineBinds << ","
+                     << stats.descriptorSetBinds << ","
+                     << stats.vertexBufferBinds << ","
+                     << stats.indexBufferBinds << ","
+                     << stats.bufferUploads << ","
+                     << stats.bytesUploaded << ","
+                     << stats.stagingCopies << ","
+                     << stats.singleTimeSubmits << "\n";
+            return;
+        }
+
+        if (!isFirstRow) dumpFile << ",";
+        isFirstRow = false;
+
+        dumpFile << "\n{\"frame\":" << stats.frame
+                 << ",\"drawCalls\":" << stats.drawCalls
+                 << ",\"verticesDrawn\":" << stats.verticesDrawn
+                 << ",\"pipelineBinds\":" << stats.pipelineBinds
+                 << ",\"descriptorSetBinds\":" << stats.descriptorSetBinds
+                 << ",\"vertexBufferBinds\":" << stats.vertexBufferBinds
+                 << ",\"indexBufferBinds\":" << stats.indexBufferBinds
+                 << ",\"bufferUploads\":" << stats.bufferUploads
+                 << ",\"bytesUploaded\":" << stats.bytesUploaded
+                 << ",\"stagingCopies\":" << stats.stagingCopies
+                 << ",\"singleTimeSubmits\":" << stats.singleTimeSubmits << "}";
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../Core.h"
+
+#include <atomic>
+#include <fstream>
+
+namespace SnekVk
+{
+    /**
+     * @brief A snapshot of everything the renderer did over a single frame.
+     */
+    struct RendererStats
+    {
+        u64 frame = 0;
+
+        u64 drawCalls = 0;
+        // Vertices (or indices for indexed draws) submitted across all draw calls.
+        u64 verticesDrawn = 0;
+        u64 pipelineBinds = 0;
+        u64 descriptorSetBinds = 0;
+        u64 vertexBufferBinds = 0;
+        u64 indexBufferBinds = 0;
+
+        // Host writes into mapped buffers.
+        u64 bufferUploads = 0;
+        u64 bytesUploaded = 0;
+        // Device-side copies out of staging buffers.
+        u64 stagingCopies = 0;
+        u64 singleTimeSubmits = 0;
+    };
+
+    /**
+     * @brief RenderStatistics counts the work recorded and uploaded by the renderer. Counters are accumulated
+     * over a frame and then collected into a RendererStats snapshot when the frame ends. Counters can be
+     * incremented from any thread.
+     *
+     * Snapshots can optionally be appended to a CSV or JSON file every frame for offline analysis.
+     */
+    class RenderStatistics
+    {
+        public:
+
+        enum Counter
+        {
+            DRAW_CALLS = 0,
+            VERTICES_DRAWN = 1,
+            PIPELINE_BINDS = 2,
+            DESCRIPTOR_SET_BINDS = 3,
+            VERTEX_BUFFER_BINDS = 4,
+            INDEX_BUFFER_BINDS = 5,
+            BUFFER_UPLOADS = 6,
+            BYTES_UPLOADED = 7,
+            STAGING_COPIES = 8,
+            SINGLE_TIME_SUBMITS = 9,
+            COUNTER_COUNT = 10
+        };
+
+        enum DumpFormat
+        {
+            CSV = 0,
+            JSON = 1
+        };
+
+        static void Increment(Counter counter, u64 amount = 1)
+        {
+            counters[counter].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Collects the current counters into a snapshot, resets them, and writes the snapshot to
+         * the dump file (if one is open).
+         */
+        static void EndFrame();
+
+        /**
+         * @brief Returns the statistics of the last completed frame.
+         */
+        static const RendererStats& GetLastFrame() { return lastFrame; }
+
+        /**
+         * @brief Starts writing the statistics of every frame to a file. Any existing dump is closed first.
+         *
+         * @param filePath the path of the file to write.
+         * @param format the format to write the file in.
+         * @return true if the file could be opened.
+         */
+        static bool StartDump(const char* filePath, DumpFormat format = CSV);
+
+        /**
+         * @brief Stops writing statistics and closes the dump file.
+         */
+        static void StopDump();
+
+        private:
+
+        static void WriteRow(const RendererStats& stats);
+
+        static std::atomic<u64> counters[COUNTER_COUNT];
+
+        static RendererStats lastFrame;
+        static u64 frameCount;
+
+        static std::ofstream dumpFile;
+        static DumpFormat dumpFormat;
+        static bool isFirstRow;
+    };
+}
@@ -57,6 +57,33 @@ namespace SnekVk
 
         SNEK_ASSERT(vkCreateRenderPass(device->Device(), &renderPassCreateInfo, nullptr, OUT &renderPass) == VK_SUCCESS,
                     "Failed to create render pass!")
+
+        // Render pass compatibility only depends on attachment formats, sample counts and
+        // how subpasses reference them. Load/store ops and layouts are ignored.
+        compatibilityKey.clear();
+
+        for (size_t i = 0; i < attachments.Count(); i++)
+        {
+            auto& attachment = attachments.Data()[i];
+            Utils::AppendKey(compatibilityKey, attachment.format, attachment.samples);
+        }
+
+        for (size_t i = 0; i < subPasses.Count(); i++)
+        {
+            auto& subPass = subPasses.Data()[i];
+
+            Utils::AppendKey(compatibilityKey, subPass.pipelineBindPoint, subPass.colorAttachmentCount);
+
+            for (size_t j = 0; j < subPass.colorAttachmentCount; j++)
+            {
+                Utils::AppendKey(compatibilityKey, subPass.pColorAttachments[j].attachment);
+            }
+
+            // A marker is appended either way, so that subpasses with and without depth can't match.
+            u32 depthAttachment = subPass.pDepthStencilAttachment ? subPass.pDepthStencilAttachment->attachment 
+                                                                  : VK_ATTACHMENT_UNUSED;
+            Utils::AppendKey(compatibilityKey, depthAttachment);
+        }
     }
 
     void RenderPass::Initialise(VulkanDevice* device, RenderPass &renderpass, const RenderPass::Config &config) {
@@ -170,6 +170,15 @@ namespace SnekVk
          */
         VkRenderPass GetRenderPass() { return renderPass; }
 
+        /**
+         * @brief Returns a key describing the RenderPass' compatibility. Two RenderPasses with the same
+         * attachment formats, sample counts and subpass references share a key, meaning pipelines 
+         * created for one can be used with the other.
+         *
+         * @return the RenderPass' compatibility key.
+         */
+        const std::string& GetCompatibilityKey() const { return compatibilityKey; }
+
         /**
          * @brief Cleans up the Vulkan RenderPass object.
          */
@@ -184,6 +193,7 @@ namespace SnekVk
     private:
         VkRenderPass renderPass {VK_NULL_HANDLE};
         VulkanDevice* device {nullptr};
+        std::string compatibilityKey;
     };
 }
 
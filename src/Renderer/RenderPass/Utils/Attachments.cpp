@@ -2,7 +2,7 @@
 
 namespace SnekVk
 {
-    VkAttachmentDescription Attachments::CreateColorAttachment(VkFormat format)
+    VkAttachmentDescription Attachments::CreateColorAttachment(VkFormat format, VkImageLayout finalLayout)
     {
         return CreateAttachment(format,
                                 VK_SAMPLE_COUNT_1_BIT,
@@ -11,7 +11,7 @@ namespace SnekVk
                                 VK_ATTACHMENT_LOAD_OP_DONT_CARE, // No stencil data, so we don't care what happens here
                                 VK_ATTACHMENT_STORE_OP_DONT_CARE, // We don't care about the results of our stencil operations either
                                 VK_IMAGE_LAYOUT_UNDEFINED,
-                                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR); // In the end we want this image to end up ready for presentation
+                                finalLayout); // In the end we want this image to end up ready for presentation
     }
 
     VkAttachmentDescription Attachments::CreateDepthAttachment(VkFormat format)
@@ -177,9 +177,12 @@ namespace SnekVk
          * @brief Creates a default Color Attachment.
          *
          * @param format The image format. This will be the standard image format that our swapchain supports
+         * @param finalLayout The layout the image is transitioned to at the end of the render pass. Offscreen 
+         * targets can't use the present layout, since it requires the swapchain extension. 
          * @return A VkAttachmentDescription with default color attachment settings
          */
-        static VkAttachmentDescription CreateColorAttachment(VkFormat format);
+        static VkAttachmentDescription CreateColorAttachment(VkFormat format, 
+                                                             VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
         /**
          * @brief Creates a default Depth Attachment.
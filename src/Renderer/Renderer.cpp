@@ -6,12 +6,26 @@ namespace SnekVk
     VulkanDevice* Renderer::deviceInstance = nullptr;
 
     Renderer::Renderer(Window& window) : 
-        window{window},
+        window{&window},
         swapChain{SwapChain(device)}
     {
         device.SetWindow(&window);
         swapChain.SetWindowExtents(window.GetExtent());
 
+        Initialise();
+    }
+
+    Renderer::Renderer(VkExtent2D extent) : 
+        swapChain{SwapChain(device)}
+    {
+        device.InitialiseHeadless();
+        swapChain.InitialiseHeadless(extent);
+
+        Initialise();
+    }
+
+    void Renderer::Initialise()
+    {
         if (deviceInstance == nullptr) deviceInstance = &device;
 
         DescriptorPool::AddPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10);
@@ -21,22 +35,36 @@ namespace SnekVk
 
         DescriptorPool::BuildPool();
 
+        Pipeline::CreatePipelineCache();
+
+        FrameCapture::Initialise();
+        GpuProfiler::Initialise();
+
         Renderer3D::Initialise();
-        Renderer2D::Initialise();
 
         CreateCommandBuffers();
     }
 
     Renderer::~Renderer() 
     {
-        std::cout << "Destroying renderer" << std::endl;
+        SNEK_LOG_INFO("Destroying renderer");
+        ClearDeviceQueue();
+        FrameCapture::Destroy();
+        GpuProfiler::Destroy();
+        RenderStatistics::StopDump();
         DescriptorPool::DestroyPool();
         Renderer3D::DestroyRenderer3D();
+        FrameAllocator::Destroy();
+        // Everything released above was queued for deletion.
+        ClearDeviceQueue();
+        PipelineRegistry::DestroyRegistry();
+        Pipeline::DestroyPipelineCache();
+        ShaderModuleCache::DestroyCache();
     }
 
     void Renderer::CreateCommandBuffers()
     {
-        commandBuffers = Utils::Array<VkCommandBuffer>(SwapChain::MAX_FRAMES_IN_FLIGHT);
+        commandBuffers = Utils::Array<VkCommandBuffer>(swapChain.GetFramesInFlight());
 
         VkCommandBufferAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -50,6 +78,8 @@ namespace SnekVk
 
     void Renderer::DrawFrame()
     {
+        CPU_PROFILE_SCOPE("Renderer::DrawFrame");
+
         auto commandBuffer = GetCurrentCommandBuffer();
 
         CameraData cameraData = { mainCamera->GetProjection(), mainCamera->GetView()};
@@ -59,17 +89,21 @@ namespace SnekVk
         };
 
         Renderer3D::Render(commandBuffer, cameraData);
-        Renderer2D::Render(commandBuffer, global2DData);
+
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "Renderer2D");
+            Renderer2D::Render(commandBuffer, global2DData);
+        }
     }
 
     void Renderer::RecreateSwapChain()
     {
-        ClearDeviceQueue();
-        auto extent = window.GetExtent();
-        while(extent.width == 0 || extent.height == 0)
+        // Old swapchain resources are retired by the swapchain and destroyed once the 
+        // frames using them complete, so the device doesn't need to be idled here.
+        // Offscreen images keep their extent, so there's no window to wait on. 
+        while(window && (window->GetExtent().width == 0 || window->GetExtent().height == 0))
         {
-            extent = window.GetExtent();
-            window.WaitEvents();
+            window->WaitEvents();
         }
 
         auto oldImageFormat = swapChain.GetImageFormat();
@@ -78,13 +112,38 @@ namespace SnekVk
         // Re-create swapchain
         swapChain.RecreateSwapchain();
 
-        // Re-create the pipeline once the swapchain renderpass 
-        // becomes available again.
+        // Pipelines only need re-creating if the render pass' formats changed. Viewports
+        // and scissors are dynamic, so a resize alone keeps every pipeline. 
         if (!swapChain.CompareSwapFormats(oldImageFormat, oldDepthFormat)) 
         {
             Renderer3D::RecreateMaterials();
             Renderer2D::RecreateMaterials();
         }
+
+        // The swapchain idles the device when frames in flight change, so the old 
+        // command buffers can be freed safely.
+        if (commandBuffers.Size() != swapChain.GetFramesInFlight())
+        {
+            // Readbacks are indexed by frame, so hand them off before the indices change.
+            FrameCapture::ProcessAllFrames();
+            FreeCommandBuffers();
+            CreateCommandBuffers();
+            currentFrameIndex = 0;
+        }
+    }
+
+    void Renderer::SetFramesInFlight(u32 framesInFlight)
+    {
+        auto settings = swapChain.GetPendingSettings();
+        settings.framesInFlight = framesInFlight;
+        swapChain.SetSettings(settings);
+    }
+
+    void Renderer::SetPresentMode(SwapChain::PresentMode presentMode)
+    {
+        auto settings = swapChain.GetPendingSettings();
+        settings.presentMode = presentMode;
+        swapChain.SetSettings(settings);
     }
 
     void Renderer::FreeCommandBuffers()
@@ -92,16 +151,23 @@ namespace SnekVk
         vkFreeCommandBuffers(
             device.Device(), 
             device.GetCommandPool(), 
-            SwapChain::GetImageCount(),
+            static_cast<u32>(commandBuffers.Size()),
             commandBuffers.Data());
     }
 
     bool Renderer::StartFrame()
     {
+        CPU_PROFILE_SCOPE("Renderer::StartFrame");
+
         SNEK_ASSERT(!isFrameStarted, "Can't start a frame when a frame is already in progress!");
 
+        inputSampleTime = std::chrono::steady_clock::now();
+
         auto result = swapChain.AcquireNextImage(&currentImageIndex);
 
+        // The frame's fence has been waited on, so its readback (if any) is complete.
+        FrameCapture::ProcessFrame(currentFrameIndex);
+
         if (result == VK_ERROR_OUT_OF_DATE_KHR) 
         {
             RecreateSwapChain();
@@ -111,6 +177,14 @@ namespace SnekVk
         SNEK_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, 
             "Failed to acquire swapchain image!");
 
+        // The fence wait and image acquisition are done, so sample input 
+        // as close to recording as possible. 
+        if (inputCallback)
+        {
+            inputSampleTime = std::chrono::steady_clock::now();
+            inputCallback();
+        }
+
         isFrameStarted = true;
 
         VkCommandBuffer commandBuffer = GetCurrentCommandBuffer();
@@ -120,6 +194,9 @@ namespace SnekVk
 
         SNEK_ASSERT(vkBeginCommandBuffer(OUT commandBuffer, &beginInfo) == VK_SUCCESS,
             "Failed to begin recording command buffer");
+
+        // Queries have to be reset outside of the render pass.
+        GpuProfiler::BeginFrame(commandBuffer, currentFrameIndex);
         
         BeginSwapChainRenderPass(commandBuffer);
         
@@ -128,6 +205,8 @@ namespace SnekVk
 
     void Renderer::EndFrame()
     {
+        CPU_PROFILE_SCOPE("Renderer::EndFrame");
+
         SNEK_ASSERT(isFrameStarted, "Can't end frame while frame is not in progress!");
 
         DrawFrame();
@@ -136,15 +215,31 @@ namespace SnekVk
 
         EndSwapChainRenderPass(commandBuffer);
 
+        if (FrameCapture::IsCapturing() && swapChain.SupportsReadback())
+        {
+            FrameCapture::RecordCopy(commandBuffer, 
+                                     currentFrameIndex, 
+                                     swapChain.GetImage(currentImageIndex), 
+                                     swapChain.GetImageLayout(), 
+                                     swapChain.GetSwapChainExtent(), 
+                                     swapChain.GetSwapChainImageFormat());
+        }
+
         SNEK_ASSERT(vkEndCommandBuffer(OUT commandBuffer) == VK_SUCCESS,
             "Failed to record command buffer!");
 
         auto result = swapChain.SubmitCommandBuffers(&commandBuffer, &currentImageIndex);
 
+        inputLatency = std::chrono::duration<float, std::chrono::milliseconds::period>(
+            swapChain.GetLastSubmitTime() - inputSampleTime).count();
+
+        // Advance before any re-creation, which resets both frame counters.
+        currentFrameIndex = (currentFrameIndex + 1) % swapChain.GetFramesInFlight(); 
+
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ||
-            window.WasResized())
+            (window && window->WasResized()) || swapChain.HasPendingSettings())
         {
-            window.ResetWindowResized();
+            if (window) window->ResetWindowResized();
             RecreateSwapChain();
         } else if (result != VK_SUCCESS) 
         {
@@ -152,10 +247,14 @@ namespace SnekVk
         }
 
         isFrameStarted = false;
-        currentFrameIndex = (currentFrameIndex + 1) % SwapChain::MAX_FRAMES_IN_FLIGHT; 
+
+        RenderStatistics::EndFrame();
 
         Renderer3D::Flush();
         Renderer2D::Flush();
+
+        // Draw lists were just flushed, so the transient data they pointed to can be released.
+        FrameAllocator::EndFrame(currentFrameIndex);
     }
 
     void Renderer::BeginSwapChainRenderPass(VkCommandBuffer commandBuffer)
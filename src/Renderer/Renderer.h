@@ -3,6 +3,7 @@
 #include "Device/VulkanDevice.h"
 #include "Swapchain/Swapchain.h"
 #include "Pipeline/Pipeline.h"
+#include "Pipeline/PipelineRegistry.h"
 #include "Model/Model.h"
 #include "Camera/Camera.h"
 #include "Material/Material.h"
@@ -10,6 +11,15 @@
 #include "Renderers/Renderer3D.h"
 #include "Renderers/Renderer2D.h"
 #include "DescriptorPool/DescriptorPool.h"
+#include "DeletionQueue/DeletionQueue.h"
+#include "FrameAllocator/FrameAllocator.h"
+#include "FrameCapture/FrameCapture.h"
+#include "Profiling/GpuProfiler.h"
+#include "Profiling/CpuProfiler.h"
+#include "Profiling/RenderStatistics.h"
+
+#include <functional>
+#include <chrono>
 
 namespace SnekVk 
 {
@@ -17,7 +27,18 @@ namespace SnekVk
     {
         public:
 
+            typedef std::function<void()> InputCallback;
+
             Renderer(Window& window);
+
+            /**
+             * @brief Creates a headless renderer. No window, surface or swapchain is created. Frames are 
+             * rendered into offscreen images instead, allowing the renderer to run on machines without a
+             * display (or present support). 
+             * 
+             * @param extent the resolution of the offscreen images.
+             */
+            Renderer(VkExtent2D extent);
             ~Renderer();
 
             void DestroyRenderer();
@@ -47,10 +68,65 @@ namespace SnekVk
             bool StartFrame();
             void EndFrame();
 
-            void ClearDeviceQueue() { vkDeviceWaitIdle(device.Device()); } 
+            void ClearDeviceQueue() { vkDeviceWaitIdle(device.Device()); DeletionQueue::FlushAll(); } 
             Pipeline CreateGraphicsPipeline();
 
             void SetClearValue(float r, float g, float b, float a) { clearValue = {r, g, b, a}; }
+
+            /**
+             * @brief Sets the number of frames which can be recorded while previous frames are rendering.
+             * Takes effect when the swapchain is next re-created, which happens at the end of the current frame.
+             * 
+             * @param framesInFlight the number of frames in flight. Must be between 1 and SwapChain::MAX_FRAMES_IN_FLIGHT.
+             */
+            void SetFramesInFlight(u32 framesInFlight);
+
+            /**
+             * @brief Sets the method used to present images. Falls back to FIFO if the mode is unsupported. 
+             * Takes effect when the swapchain is next re-created, which happens at the end of the current frame.
+             * 
+             * @param presentMode the requested present mode.
+             */
+            void SetPresentMode(SwapChain::PresentMode presentMode);
+
+            /**
+             * @brief Enables low-latency mode. Rather than sampling input before StartFrame(), the callback is
+             * invoked by StartFrame() once the frame's fence has been waited on and its image acquired. Input 
+             * is therefore sampled as late as possible before recording begins. 
+             * 
+             * @param callback a function which samples input and updates any state used for rendering (such as
+             * the camera). 
+             */
+            void EnableLowLatencyMode(InputCallback&& callback) { inputCallback = std::move(callback); }
+
+            void DisableLowLatencyMode() { inputCallback = nullptr; }
+
+            bool IsLowLatencyModeEnabled() const { return inputCallback != nullptr; }
+
+            /**
+             * @brief Returns the time in milliseconds between input being sampled and the last frame being 
+             * submitted. In low-latency mode this is measured from the input callback. Otherwise, input is 
+             * assumed to be sampled just before StartFrame() is called. 
+             */
+            float GetInputLatency() const { return inputLatency; }
+
+            /**
+             * @brief Returns the draw calls, binds and uploads counted over the last completed frame.
+             */
+            const RendererStats& GetStats() const { return RenderStatistics::GetLastFrame(); }
+
+            /**
+             * @brief Appends the statistics of every frame to a file until DisableStatsDump() is called.
+             * 
+             * @param filePath the path of the file to write.
+             * @param format the format to write the file in.
+             */
+            bool EnableStatsDump(const char* filePath, RenderStatistics::DumpFormat format = RenderStatistics::CSV)
+            {
+                return RenderStatistics::StartDump(filePath, format);
+            }
+
+            void DisableStatsDump() { RenderStatistics::StopDump(); }
         private:
             static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
             
@@ -69,7 +145,9 @@ namespace SnekVk
 
             void DrawFrame();
 
-            SnekVk::Window& window;
+            void Initialise();
+
+            SnekVk::Window* window {nullptr};
             
             VulkanDevice device;
             SwapChain swapChain;
@@ -79,5 +157,9 @@ namespace SnekVk
             int currentFrameIndex{0};
 
             Camera* mainCamera;
+
+            InputCallback inputCallback;
+            std::chrono::steady_clock::time_point inputSampleTime;
+            float inputLatency {0.f};
     };
 }
@@ -2,9 +2,6 @@
 
 namespace SnekVk
 {
-    Utils::StringId Renderer2D::transformId;
-    Utils::StringId Renderer2D::globalDataId;
-
     u64 Renderer2D::transformSize = sizeof(Model::Transform2D) * MAX_OBJECT_TRANSFORMS;
 
     Utils::StackArray<Model::Transform2D, Renderer2D::MAX_OBJECT_TRANSFORMS> Renderer2D::transforms;
@@ -13,11 +10,13 @@ namespace SnekVk
     Material* Renderer2D::currentMaterial = nullptr;
     Model* Renderer2D::currentModel = nullptr;
 
-    void Renderer2D::Initialise()
-    {
-        transformId = INTERN_STR("objectBuffer");
-        globalDataId = INTERN_STR("globalData");
-    }
+    #ifdef DEBUG
+    // IDs hashed by the compiler are never interned, so their names are registered for debug lookups.
+    static const Utils::StringId registeredIds[] = {
+        Utils::RegisterStringId(Renderer2D::transformId, "objectBuffer"),
+        Utils::RegisterStringId(Renderer2D::globalDataId, "globalData")
+    };
+    #endif
 
     void Renderer2D::DrawModel(Model* model, const glm::vec2& position, const glm::vec2& scale, const float& rotation, const float& zIndex)
     {
@@ -12,13 +12,13 @@ namespace SnekVk
     {
         public:
 
+        static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
+
         struct GlobalData
         {
             CameraData cameraData;
         };
 
-        static void Initialise();
-
         static void DrawModel(Model* model, const glm::vec2& position, const glm::vec2& scale, const float& rotation, const float& zIndex);
         static void DrawModel(Model* model, const glm::vec2& position, const glm::vec2& scale, const float& zIndex);
         static void DrawModel(Model* model, const glm::vec2& position);
@@ -30,15 +30,13 @@ namespace SnekVk
 
         private:
 
-        static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
-
         static Utils::StackArray<Model::Transform2D, MAX_OBJECT_TRANSFORMS> transforms;
         static Utils::StackArray<Model*, MAX_OBJECT_TRANSFORMS> models;
 
         static u64 transformSize;
 
-        static Utils::StringId transformId;
-        static Utils::StringId globalDataId;
+        static constexpr Utils::StringId transformId = "objectBuffer"_sid;
+        static constexpr Utils::StringId globalDataId = "globalData"_sid;
 
         static Material* currentMaterial; 
         static Model* currentModel;
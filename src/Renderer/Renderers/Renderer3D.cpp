@@ -1,11 +1,11 @@
 #include "Renderer3D.h"
+#include "../Profiling/GpuProfiler.h"
+#include "../Profiling/RenderStatistics.h"
 #include <iostream>
 
 namespace SnekVk
 {
     // static initialisation
-    Utils::StringId Renderer3D::globalDataId;
-
     Material Renderer3D::gridMaterial;
 
     ModelRenderer Renderer3D::modelRenderer;
@@ -15,10 +15,15 @@ namespace SnekVk
 
     Renderer3D::GlobalData Renderer3D::global3DData;
 
+    #ifdef DEBUG
+    // IDs hashed by the compiler are never interned, so their names are registered for debug lookups.
+    static const Utils::StringId registeredIds[] = {
+        Utils::RegisterStringId(Renderer3D::globalDataId, "globalData")
+    };
+    #endif
+
     void Renderer3D::Initialise()
     {
-        globalDataId = INTERN_STR("globalData");
-
         modelRenderer.Initialise("globalData", sizeof(GlobalData));
         debugRenderer.Initialise("globalData", sizeof(GlobalData));
         billboardRenderer.Initialise("globalData", sizeof(GlobalData));
@@ -35,7 +40,14 @@ namespace SnekVk
 
         gridMaterial.SetVertexShader(&gridShader);
         gridMaterial.SetFragmentShader(&gridFragShader);
-        gridMaterial.BuildMaterial();
+
+        // Compile all pipelines concurrently rather than one after the other.
+        Material::BuildMaterials({
+            debugRenderer.GetLineMaterial(),
+            billboardRenderer.GetMaterial(),
+            lightRenderer.GetMaterial(),
+            &gridMaterial
+        });
     }
 
     void Renderer3D::DrawBillboard(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& colour)
@@ -43,9 +55,14 @@ namespace SnekVk
         billboardRenderer.DrawBillboard(position, scale, colour);
     }
 
+    void Renderer3D::DrawModel(Model* model, MaterialInstance* instance, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation)
+    {
+        modelRenderer.DrawModel(model, instance, position, scale, rotation);
+    }
+
     void Renderer3D::DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation)
     {
-        modelRenderer.DrawModel(model, position, scale, rotation);
+        DrawModel(model, nullptr, position, scale, rotation);
     }
 
     void Renderer3D::DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale)
@@ -70,12 +87,28 @@ namespace SnekVk
         global3DData.cameraData = cameraData;
         u64 globalDataSize = sizeof(global3DData);
 
-        modelRenderer.Render(commandBuffer, globalDataSize, &global3DData);
-        lightRenderer.Render(commandBuffer, globalDataSize, &global3DData);
-        debugRenderer.Render(commandBuffer, globalDataSize, &global3DData);
-        billboardRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "ModelRenderer");
+            modelRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+        }
+
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "LightRenderer");
+            lightRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+        }
+
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "DebugRenderer3D");
+            debugRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+        }
+
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "BillboardRenderer");
+            billboardRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+        }
         
         #ifdef ENABLE_GRID
+        GPU_PROFILE_SCOPE(commandBuffer, "Grid");
         RenderGrid(commandBuffer, global3DData);
         #endif
     }
@@ -91,6 +124,9 @@ namespace SnekVk
         gridMaterial.Bind(commandBuffer);
 
         vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+
+        RenderStatistics::Increment(RenderStatistics::DRAW_CALLS);
+        RenderStatistics::Increment(RenderStatistics::VERTICES_DRAWN, 6);
     }
 
     void Renderer3D::RecreateMaterials()
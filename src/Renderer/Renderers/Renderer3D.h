@@ -3,6 +3,7 @@
 #include "../Core.h"
 #include "../Model/Model.h"
 #include "../Material/Material.h"
+#include "../Material/MaterialInstance.h"
 #include "../Utils/Math.h"
 #include "../Lights/PointLight.h"
 #include "../Camera/Camera.h"
@@ -25,6 +26,7 @@ namespace SnekVk
 
         static void Initialise();
 
+        static void DrawModel(Model* model, MaterialInstance* instance, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
         static void DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
         static void DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale);
         static void DrawModel(Model* model, const glm::vec3& position);
@@ -49,7 +51,7 @@ namespace SnekVk
         //static void RenderRects(VkCommandBuffer& commandBuffer, const GlobalData& globalData);
         static void RenderGrid(VkCommandBuffer& commandBuffer, const GlobalData& globalData);
 
-        static Utils::StringId globalDataId;
+        static constexpr Utils::StringId globalDataId = "globalData"_sid;
 
         // FIXME(Aryeh): Everything below this needs to change.
 
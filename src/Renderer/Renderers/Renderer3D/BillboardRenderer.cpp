@@ -8,24 +8,23 @@ namespace SnekVk
     void BillboardRenderer::Initialise(const char* globalDataAttributeName, const u64& globalDataSize)
     {
         globalDataId = INTERN_STR(globalDataAttributeName);
-        positionsId = INTERN_STR("positions");
+        positionsId = Utils::RegisterStringId("positions"_sid, "positions");
 
-        auto vertexShader = Shader::BuildShader()
+        vertexShader = Shader::BuildShader()
             .FromShader("shaders/billboard.vert.spv")
             .WithStage(PipelineConfig::VERTEX)
             .WithVertexType(sizeof(BillboardVertex))
             .WithVertexAttribute(offsetof(BillboardVertex, position), SnekVk::VertexDescription::VEC3)
             .WithVertexAttribute(offsetof(BillboardVertex, colour), SnekVk::VertexDescription::VEC4)
             .WithUniform(0, globalDataAttributeName, globalDataSize)
-            .WithStorage(1, "positions", sizeof(BillboardUBO), 1000);
+            .WithStorage(1, "positions", sizeof(BillboardUBO), MAX_BILLBOARDS);
         
-        auto fragmentShader = Shader::BuildShader()
+        fragmentShader = Shader::BuildShader()
             .FromShader("shaders/billboard.frag.spv")
             .WithStage(PipelineConfig::FRAGMENT);
         
         billboardMaterial.SetVertexShader(&vertexShader);
         billboardMaterial.SetFragmentShader(&fragmentShader);
-        billboardMaterial.BuildMaterial();
 
         billboardModel.SetMesh({
             sizeof(BillboardVertex),
@@ -51,6 +50,8 @@ namespace SnekVk
 
     void BillboardRenderer::DrawBillboard(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& colour) 
     {
+        SNEK_ASSERT(positions.Count() < MAX_BILLBOARDS, "Too many billboards drawn in a single frame!");
+
         vertices.Append({{1.f, 1.f, 1.f}, colour});
         vertices.Append({{1.f, -1.f, 1.f}, colour});
         vertices.Append({{-1.f, -1.f, 1.f}, colour});
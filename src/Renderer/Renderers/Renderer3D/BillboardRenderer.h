@@ -3,6 +3,7 @@
 #include "../../Core.h"
 #include "../../Material/Material.h"
 #include "../../Model/Model.h"
+#include "../../FrameAllocator/FrameAllocator.h"
 
 namespace SnekVk
 {
@@ -10,6 +11,9 @@ namespace SnekVk
     {
         public:
 
+        // Billboard positions are read from a storage buffer of this size.
+        static constexpr size_t MAX_BILLBOARDS = 1000;
+
         BillboardRenderer();
         ~BillboardRenderer();
 
@@ -24,6 +28,9 @@ namespace SnekVk
 
         void RecreateMaterials();
 
+        // Materials are built by the Renderer3D so that all pipelines can be compiled together.
+        Material* GetMaterial() { return &billboardMaterial; }
+
         private:
 
         struct BillboardVertex 
@@ -40,14 +47,17 @@ namespace SnekVk
 
         u32 billboardCount;
 
+        Shader vertexShader;
+        Shader fragmentShader;
+
         Material billboardMaterial;
         Model billboardModel;
 
         Utils::StringId globalDataId;
         Utils::StringId positionsId;
 
-        Utils::StackArray<BillboardVertex, Mesh::MAX_VERTICES> vertices;
-        Utils::StackArray<u32, Mesh::MAX_INDICES> indices;
-        Utils::StackArray<BillboardUBO, 1000> positions;
+        FrameArray<BillboardVertex> vertices;
+        FrameArray<u32> indices;
+        FrameArray<BillboardUBO> positions;
     };
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace SnekVk
         globalDataId = INTERN_STR(globalDataAttributeName);
         
         // vertex Shaders
-        auto vertexShader = Shader::BuildShader()
+        vertexShader = Shader::BuildShader()
             .FromShader("shaders/line.vert.spv")
             .WithStage(PipelineConfig::VERTEX)
             .WithVertexType(sizeof(LineVertex))
@@ -20,14 +20,13 @@ namespace SnekVk
             .WithUniform(0, globalDataAttributeName, globalDataSize, 1);
         
         // fragmentShaders
-        auto fragmentShader = Shader::BuildShader()
+        fragmentShader = Shader::BuildShader()
             .FromShader("shaders/line.frag.spv")
             .WithStage(PipelineConfig::FRAGMENT);
         
         lineMaterial.SetVertexShader(&vertexShader);
         lineMaterial.SetFragmentShader(&fragmentShader);
         lineMaterial.SetTopology(Material::Topology::LINE_LIST);
-        lineMaterial.BuildMaterial();
 
         // Set empty mesh
         lineModel.SetMesh({
@@ -70,6 +69,7 @@ namespace SnekVk
     void DebugRenderer3D::Flush()
     {
         lines.Clear();
+        rects.Clear();
     }
 
     void DebugRenderer3D::RenderLines(VkCommandBuffer& commandBuffer, const u64& globalDataSize, const void* globalData)
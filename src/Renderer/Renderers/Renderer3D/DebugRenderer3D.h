@@ -3,6 +3,7 @@
 #include "../../Core.h"
 #include "../../Model/Model.h"
 #include "../../Material/Material.h"
+#include "../../FrameAllocator/FrameAllocator.h"
 
 namespace SnekVk
 {
@@ -26,6 +27,9 @@ namespace SnekVk
 
         void RecreateMaterials();
 
+        // Materials are built by the Renderer3D so that all pipelines can be compiled together.
+        Material* GetLineMaterial() { return &lineMaterial; }
+
         private: 
 
         struct LineVertex
@@ -39,6 +43,9 @@ namespace SnekVk
 
         glm::vec3 lineColor;
 
+        Shader vertexShader;
+        Shader fragmentShader;
+
         Material lineMaterial;
         Model lineModel;
 
@@ -47,7 +54,7 @@ namespace SnekVk
 
         Utils::StringId globalDataId;
 
-        Utils::StackArray<LineVertex, Mesh::MAX_VERTICES> lines;
-        Utils::StackArray<glm::vec3, Mesh::MAX_VERTICES> rects;
+        FrameArray<LineVertex> lines;
+        FrameArray<glm::vec3> rects;
     };
 }
\ No newline at end of file
@@ -8,23 +8,22 @@ namespace SnekVk
     void LightRenderer::Initialise(const char* globalDataAttributeName, const u64& globalDataSize)
     {
         globalDataId = INTERN_STR(globalDataAttributeName);
-        lightDataId = INTERN_STR("lightUBO");
+        lightDataId = Utils::RegisterStringId("lightUBO"_sid, "lightUBO");
 
-        auto pointLightVertShader = SnekVk::Shader::BuildShader()
+        pointLightVertShader = SnekVk::Shader::BuildShader()
             .FromShader("shaders/pointLight.vert.spv")
             .WithStage(SnekVk::PipelineConfig::VERTEX)
             .WithVertexType(sizeof(glm::vec2))
             .WithVertexAttribute(0, SnekVk::VertexDescription::VEC2)
             .WithUniform(0, globalDataAttributeName, globalDataSize);
 
-        auto pointLightFragShader = SnekVk::Shader::BuildShader()
+        pointLightFragShader = SnekVk::Shader::BuildShader()
             .FromShader("shaders/pointLight.frag.spv")
             .WithStage(SnekVk::PipelineConfig::FRAGMENT)
             .WithUniform(0, globalDataAttributeName, globalDataSize);
         
         lightMaterial.SetVertexShader(&pointLightVertShader);
         lightMaterial.SetFragmentShader(&pointLightFragShader);
-        lightMaterial.BuildMaterial();
 
         lightModel.SetMesh({ 
             sizeof(glm::vec2),
@@ -2,6 +2,7 @@
 
 #include "../../Core.h"
 #include "../../Model/Model.h"
+#include "../../FrameAllocator/FrameAllocator.h"
 
 namespace SnekVk
 {
@@ -24,6 +25,9 @@ namespace SnekVk
 
         void RecreateMaterials();
 
+        // Materials are built by the Renderer3D so that all pipelines can be compiled together.
+        Material* GetMaterial() { return &lightMaterial; }
+
         private: 
 
         struct PointLightVertex
@@ -38,13 +42,16 @@ namespace SnekVk
             alignas(16) float radius = .05f;
         };
 
+        Shader pointLightVertShader;
+        Shader pointLightFragShader;
+
         Model lightModel;
         Material lightMaterial;
 
         Utils::StringId globalDataId;
         Utils::StringId lightDataId;
 
-        Utils::StackArray<glm::vec2, Mesh::MAX_VERTICES> pointLightVertices;
-        Utils::StackArray<u32, Mesh::MAX_INDICES> pointLightIndices;
+        FrameArray<glm::vec2> pointLightVertices;
+        FrameArray<u32> pointLightIndices;
     };
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace SnekVk
     void ModelRenderer::Initialise(const char* globalDataAttributeName, const u64& globalDataSize) 
     {
         globalDataId = INTERN_STR(globalDataAttributeName);
-        transformId = INTERN_STR("objectBuffer");
+        transformId = Utils::RegisterStringId("objectBuffer"_sid, "objectBuffer");
     }
 
     void ModelRenderer::Destroy()
@@ -16,9 +16,10 @@ namespace SnekVk
 
     }
 
-    void ModelRenderer::DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation)
+    void ModelRenderer::DrawModel(Model* model, MaterialInstance* instance, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation)
     {
         models.Append(model);
+        instances.Append(instance);
 
         auto transform = Utils::Math::CalculateTransform3D(position, rotation, scale);
         auto normal = Utils::Math::CalculateNormalMatrix(rotation, scale);
@@ -32,15 +33,29 @@ namespace SnekVk
         for (size_t i = 0; i < models.Count(); i++)
         {
             auto& model = models.Get(i);
+            auto& instance = instances.Get(i);
 
-            if (currentMaterial != model->GetMaterial())
+            // Instances draw with their parent's pipeline. 
+            auto material = instance ? instance->GetParent() : model->GetMaterial();
+
+            if (currentMaterial != material)
             {
-                currentMaterial = model->GetMaterial();
+                currentMaterial = material;
                 currentMaterial->SetUniformData(transformId, sizeof(transforms[0]) * transforms.Count(), transforms.Data());
                 currentMaterial->SetUniformData(globalDataId, globalDataSize, globalData);
                 currentMaterial->Bind(commandBuffer);
+                currentInstanceSlot = 0;
             } 
 
+            // Switching between instances of the same material only changes the parameter index.
+            u32 instanceSlot = instance ? instance->GetSlot() : 0;
+
+            if (currentInstanceSlot != instanceSlot)
+            {
+                currentInstanceSlot = instanceSlot;
+                currentMaterial->BindInstance(commandBuffer, instanceSlot);
+            }
+
             if (currentModel != model)
             {
                 currentModel = model;
@@ -52,12 +67,14 @@ namespace SnekVk
 
         currentModel = nullptr;
         currentMaterial = nullptr;
+        currentInstanceSlot = 0;
     }
 
     void ModelRenderer::Flush()
     {
         transforms.Clear();
         models.Clear();
+        instances.Clear();
     }
 
     void ModelRenderer::RecreateMaterials()
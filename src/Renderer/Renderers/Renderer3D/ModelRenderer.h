@@ -2,6 +2,7 @@
 
 #include "../../Core.h"
 #include "../../Model/Model.h"
+#include "../../Material/MaterialInstance.h"
 #include "../../Utils/Math.h"
 
 namespace SnekVk
@@ -10,13 +11,16 @@ namespace SnekVk
     {
         public:
 
+        // TODO(Aryeh): Make this configurable via macros
+        static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
+
         ModelRenderer();
         ~ModelRenderer();
 
         void Initialise(const char* globalDataAttributeName, const u64& globalDataSize);
         void Destroy();
 
-        void DrawModel(Model* model, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
+        void DrawModel(Model* model, MaterialInstance* instance, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
 
         void Render(VkCommandBuffer& commandBuffer, const u64& globalDataSize, const void* globalData);
 
@@ -26,16 +30,15 @@ namespace SnekVk
 
         private:
 
-        // TODO(Aryeh): Make this configurable via macros
-        static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
-
         Utils::StringId globalDataId;
         Utils::StringId transformId;
 
         Utils::StackArray<Model::Transform, MAX_OBJECT_TRANSFORMS> transforms;
         Utils::StackArray<Model*, MAX_OBJECT_TRANSFORMS> models;
+        Utils::StackArray<MaterialInstance*, MAX_OBJECT_TRANSFORMS> instances;
 
         Material* currentMaterial {nullptr}; 
         Model* currentModel {nullptr};
+        u32 currentInstanceSlot = 0;
     };
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ namespace SnekVk
     {
         SetUniformType(binding, name, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, size, arraySize);
 
-        std::cout << "Added uniform " << name << " for binding: " << binding << std::endl;
+        SNEK_LOG_TRACE("Added uniform " << name << " for binding: " << binding);
 
         return *this;
     }
@@ -43,7 +43,7 @@ namespace SnekVk
             arraySize,
             count);
 
-        std::cout << "Added dynamic uniform " << name << " for binding: " << binding << std::endl;
+        SNEK_LOG_TRACE("Added dynamic uniform " << name << " for binding: " << binding);
 
         return *this;
     }
@@ -52,7 +52,7 @@ namespace SnekVk
     {
         SetUniformType(binding, name, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, size, arraySize);
 
-        std::cout << "Added storage " << name << "for binding: " << binding << std::endl;
+        SNEK_LOG_TRACE("Added storage " << name << " for binding: " << binding);
 
         return *this;
     }
@@ -67,21 +67,18 @@ namespace SnekVk
             arraySize,
             count);
 
-        std::cout << "Added dynamic storage " << name << " for binding: " << binding << std::endl;
+        SNEK_LOG_TRACE("Added dynamic storage " << name << " for binding: " << binding);
 
         return *this;
     }
 
     Shader& Shader::WithVertexType(u32 size)
     {
-        size_t index = vertexBindings.Count();
-
-        vertexBindings.Activate(index);
-        auto& binding = vertexBindings.Get(index);
+        auto& binding = vertexBindings.Append();
         binding.vertexStride = size;
 
-        std::cout << "Added new vertex type of size " << size << std::endl;
-        std::cout << "There are now " << vertexBindings.Count() << " bindings" << std::endl;
+        SNEK_LOG_TRACE("Added new vertex type of size " << size);
+        SNEK_LOG_TRACE("There are now " << vertexBindings.Count() << " bindings");
 
         return *this;
     }
@@ -97,8 +94,8 @@ namespace SnekVk
 
         attributes.Append({offset, type});
 
-        std::cout << "Added new vertex attribute for binding " << index << std::endl;
-        std::cout << "Binding now has " << binding.attributes.Count() << " attributes" << std::endl;
+        SNEK_LOG_TRACE("Added new vertex attribute for binding " << index);
+        SNEK_LOG_TRACE("Binding now has " << binding.attributes.Count() << " attributes");
 
         return *this;
     }
@@ -1,4 +1,6 @@
 #include "Swapchain.h"
+#include "../DeletionQueue/DeletionQueue.h"
+#include "../Profiling/CpuProfiler.h"
 
 namespace SnekVk
 {
@@ -27,15 +29,25 @@ namespace SnekVk
         Init();
     }
 
-    void SwapChain::ClearSwapChain(bool isRecreated)
+    void SwapChain::InitialiseHeadless(VkExtent2D extent)
+    {
+        headless = true;
+        this->windowExtent = extent;
+        Init();
+    }
+
+    void SwapChain::ClearSwapChain()
     {
         u32 imageCount = FrameImages::GetImageCount();
 
+        // Retired swapchains are held by the deletion queue. 
+        DeletionQueue::FlushAll();
+
         swapchainImages.DestroyFrameImages();
 
-        if (!isRecreated && swapChain != nullptr)
+        if (swapChain != nullptr)
         {
-            std::cout << "Clearing Swapchain" << std::endl;
+            SNEK_LOG_TRACE("Clearing Swapchain");
             vkDestroySwapchainKHR(device.Device(), GetSwapChain(), nullptr);
             swapChain = nullptr;
         }
@@ -47,12 +59,7 @@ namespace SnekVk
             vkDestroyFramebuffer(device.Device(), swapChainFrameBuffers[i], nullptr);
         }
         
-        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-        {
-            vkDestroySemaphore(device.Device(), renderFinishedSemaphores[i], nullptr);
-            vkDestroySemaphore(device.Device(), imageAvailableSemaphores[i], nullptr);
-            vkDestroyFence(device.Device(), inFlightFences[i], nullptr);
-        }
+        DestroySyncObjects();
     }
 
     void SwapChain::ClearMemory()
@@ -69,14 +76,116 @@ namespace SnekVk
         imagesInFlight = nullptr;
     }
 
+    void SwapChain::SetSettings(const Settings& settings)
+    {
+        SNEK_ASSERT(settings.framesInFlight > 0 && settings.framesInFlight <= MAX_FRAMES_IN_FLIGHT,
+            "Frames in flight must be between 1 and MAX_FRAMES_IN_FLIGHT!");
+
+        pendingSettings = settings;
+    }
+
     void SwapChain::RecreateSwapchain()
     {
-        std::cout << "Re-creating Swapchain" << std::endl;
-        // Destroy all Vulkan structs
-        ClearSwapChain(true);
+        SNEK_LOG_INFO("Re-creating Swapchain");
 
-        // Re-create all Vulkan structs
-        Init();
+        bool framesInFlightChanged = pendingSettings.framesInFlight != settings.framesInFlight;
+
+        if (framesInFlightChanged)
+        {
+            SNEK_LOG_INFO("Frames in flight changed to " << pendingSettings.framesInFlight);
+
+            // Every per-frame object is re-sized. This only happens when the settings are
+            // changed explicitly, so stalling is acceptable here. The old objects are destroyed
+            // before the settings change, since they were created for the old frame count.
+            vkDeviceWaitIdle(device.Device());
+            DeletionQueue::FlushAll();
+            DestroySyncObjects();
+        }
+
+        settings = pendingSettings;
+
+        if (framesInFlightChanged)
+        {
+            CreateSyncObjects();
+            currentFrame = 0;
+        }
+
+        // Frames in flight may still be rendering to the old images, so they're
+        // kept alive until those frames complete. 
+        RetireResources();
+
+        // The old swapchain is handed to the new one so that presentation can
+        // continue while the new swapchain is created. 
+        CreateSwapChain();
+        CreateImageViews();
+
+        // The render pass only depends on our formats. If these haven't changed then
+        // the existing render pass (and every pipeline built against it) can be kept.
+        if (GetSwapChainImageFormat() != swapChainImageFormat || FindDepthFormat() != swapChainDepthFormat)
+        {
+            SNEK_LOG_INFO("Swapchain formats changed, re-creating render pass");
+
+            // Recorded command buffers reference the old render pass. This is rare enough
+            // that stalling is acceptable here. 
+            vkDeviceWaitIdle(device.Device());
+            renderPass.DestroyRenderPass();
+            CreateRenderPass();
+        }
+
+        CreateDepthResources();
+        CreateFrameBuffers();
+        CreateImagesInFlight();
+    }
+
+    void SwapChain::RetireResources()
+    {
+        RetiredResources resources;
+
+        resources.swapChain = swapChain;
+        resources.imageCount = FrameImages::GetImageCount();
+
+        for (size_t i = 0; i < resources.imageCount; i++)
+        {
+            if (headless)
+            {
+                resources.colorImages[i] = swapchainImages.GetImage(i);
+                resources.colorImageMemorys[i] = swapchainImages.GetImageMemorys()[i];
+            }
+
+            resources.frameBuffers[i] = swapChainFrameBuffers[i];
+            resources.colorImageViews[i] = swapchainImages.GetImageView(i);
+            resources.depthImageViews[i] = depthImages.GetImageView(i);
+            resources.depthImages[i] = depthImages.GetImage(i);
+            resources.depthImageMemorys[i] = depthImages.GetImageMemorys()[i];
+        }
+
+        VkDevice logicalDevice = device.Device();
+
+        DeletionQueue::Enqueue([logicalDevice, resources]() {
+            DestroyRetiredResources(logicalDevice, resources);
+        });
+
+        // The image count may change with the new swapchain.
+        delete [] swapChainFrameBuffers;
+        swapChainFrameBuffers = nullptr;
+    }
+
+    void SwapChain::DestroyRetiredResources(VkDevice device, const RetiredResources& resources)
+    {
+        for (size_t i = 0; i < resources.imageCount; i++)
+        {
+            vkDestroyFramebuffer(device, resources.frameBuffers[i], nullptr);
+            vkDestroyImageView(device, resources.colorImageViews[i], nullptr);
+            vkDestroyImageView(device, resources.depthImageViews[i], nullptr);
+            vkDestroyImage(device, resources.depthImages[i], nullptr);
+            vkFreeMemory(device, resources.depthImageMemorys[i], nullptr);
+            vkDestroyImage(device, resources.colorImages[i], nullptr);
+            vkFreeMemory(device, resources.colorImageMemorys[i], nullptr);
+        }
+
+        // Swapchain images are owned by the swapchain itself. Swapchain functions
+        // aren't loaded when running headless.
+        if (resources.swapChain != VK_NULL_HANDLE) vkDestroySwapchainKHR(device, resources.swapChain, nullptr);
     }
 
     bool SwapChain::CompareSwapFormats(VkFormat oldImageFormat, VkFormat oldDepthFormat)
@@ -86,12 +195,15 @@ namespace SnekVk
 
     void SwapChain::Init()
     {
+        settings = pendingSettings;
+
         CreateSwapChain();
         CreateImageViews();
         CreateRenderPass();
         CreateDepthResources();
         CreateFrameBuffers();
         CreateSyncObjects();
+        CreateImagesInFlight();
 
         if (instance == nullptr) instance = this;
     }
@@ -99,6 +211,17 @@ namespace SnekVk
     // TODO: Clean this function
     void SwapChain::CreateSwapChain()
     {
+        if (headless)
+        {
+            // Every frame in flight renders to its own image, so images are never shared between frames.
+            FrameImages::SetImageCount(settings.framesInFlight);
+
+            swapchainImages = FrameImages(&device, VK_FORMAT_B8G8R8A8_SRGB);
+            swapChainExtent = windowExtent;
+            supportsReadback = true;
+            return;
+        }
+
         // Get our swapchain details
         SwapChainSupportDetails::SwapChainSupportDetails details = device.GetSwapChainSupport();
 
@@ -113,7 +236,7 @@ namespace SnekVk
         // The size of our images. 
         VkExtent2D extent = ChooseSwapExtent(details.capabilities);
 
-        std::cout << "Extent: " << extent.width << "x" << extent.height << std::endl;
+        SNEK_LOG_INFO("Extent: " << extent.width << "x" << extent.height);
 
         // Get the image count we can support 
         u32 imageCount = details.capabilities.minImageCount + 1;
@@ -123,7 +246,7 @@ namespace SnekVk
         {
             imageCount = details.capabilities.maxImageCount;
         }   
-        std::cout << "FrameImages Count: " << imageCount << std::endl;
+        SNEK_LOG_INFO("FrameImages Count: " << imageCount);
 
         // Now we populate the base swapchain creation struct
         VkSwapchainCreateInfoKHR createInfo {};
@@ -136,6 +259,10 @@ namespace SnekVk
         createInfo.imageExtent = extent;
         createInfo.imageArrayLayers = 1;
         createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        // Allows frames to be captured when the surface supports it.
+        supportsReadback = details.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        if (supportsReadback) createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
         
         // Get our image queue information for rendering
         QueueFamilyIndices::QueueFamilyIndices indices = device.FindPhysicalQueueFamilies();
@@ -184,6 +311,12 @@ namespace SnekVk
 
     void SwapChain::CreateImageViews()
     {
+        if (headless)
+        {
+            swapchainImages.InitOffscreenColorImage2D(swapChainExtent.width, swapChainExtent.height);
+            return;
+        }
+
         swapchainImages.InitColorImageView2D();
     }
 
@@ -191,10 +324,14 @@ namespace SnekVk
     {
         swapChainImageFormat = GetSwapChainImageFormat();
         swapChainDepthFormat = FindDepthFormat();
+
+        // Offscreen images are never presented. Leave them ready to be copied from instead.
+        VkImageLayout colorLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
         RenderPass::Initialise(&device,
                                OUT renderPass,
                               RenderPass::CreateConfig()
-                              .WithAttachment(Attachments::CreateColorAttachment(swapChainImageFormat))
+                              .WithAttachment(Attachments::CreateColorAttachment(swapChainImageFormat, colorLayout))
                               .WithAttachment(Attachments::CreateDepthAttachment(swapChainDepthFormat))
                               .WithSubPass(Attachments::CreateSubPass()
                                             .WithColorReference(Attachments::CreateColorAttachmentReference(0))
@@ -259,17 +396,25 @@ namespace SnekVk
         }
     }
 
-    void SwapChain::CreateSyncObjects()
+    void SwapChain::CreateImagesInFlight()
     {
         u32 imageCount = FrameImages::GetImageCount();
-        
-        if (imageAvailableSemaphores == nullptr) imageAvailableSemaphores = new VkSemaphore[MAX_FRAMES_IN_FLIGHT];
-        if (renderFinishedSemaphores == nullptr) renderFinishedSemaphores = new VkSemaphore[MAX_FRAMES_IN_FLIGHT];
-        if (inFlightFences == nullptr) inFlightFences = new VkFence[MAX_FRAMES_IN_FLIGHT];
-        if (imagesInFlight == nullptr) imagesInFlight = new VkFence[imageCount];
+
+        // The image count may differ between swapchains.
+        delete [] imagesInFlight;
+        imagesInFlight = new VkFence[imageCount];
 
         // Set all images in flight to null
         for (size_t i = 0; i < imageCount; i++) imagesInFlight[i] = VK_NULL_HANDLE;
+    }
+
+    void SwapChain::CreateSyncObjects()
+    {
+        u32 framesInFlight = settings.framesInFlight;
+
+        imageAvailableSemaphores = new VkSemaphore[framesInFlight];
+        renderFinishedSemaphores = new VkSemaphore[framesInFlight];
+        inFlightFences = new VkFence[framesInFlight];
 
         // Create our semaphore and fence create info
         VkSemaphoreCreateInfo semaphoreInfo{};
@@ -280,7 +425,7 @@ namespace SnekVk
         fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
         // Create the synchronisation objects
-        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        for (size_t i = 0; i < framesInFlight; i++)
         {
             SNEK_ASSERT(
                 vkCreateSemaphore(device.Device(), &semaphoreInfo, nullptr, OUT &imageAvailableSemaphores[i]) == VK_SUCCESS &&
@@ -290,8 +435,30 @@ namespace SnekVk
         }
     }
 
+    void SwapChain::DestroySyncObjects()
+    {
+        if (inFlightFences == nullptr) return;
+
+        for (size_t i = 0; i < settings.framesInFlight; i++)
+        {
+            vkDestroySemaphore(device.Device(), renderFinishedSemaphores[i], nullptr);
+            vkDestroySemaphore(device.Device(), imageAvailableSemaphores[i], nullptr);
+            vkDestroyFence(device.Device(), inFlightFences[i], nullptr);
+        }
+
+        delete [] imageAvailableSemaphores;
+        delete [] renderFinishedSemaphores;
+        delete [] inFlightFences;
+
+        imageAvailableSemaphores = nullptr;
+        renderFinishedSemaphores = nullptr;
+        inFlightFences = nullptr;
+    }
+
     VkResult SwapChain::AcquireNextImage(u32* imageIndex)
     {
+        CPU_PROFILE_SCOPE("SwapChain::AcquireNextImage");
+
         // Wait for the image of the current frame to become available
         vkWaitForFences(
             device.Device(), 
@@ -300,6 +467,17 @@ namespace SnekVk
             VK_TRUE, 
             std::numeric_limits<u64>::max());
 
+        // This frame's previous submission has completed, so anything destroyed 
+        // before it may now be safe to release.
+        DeletionQueue::Flush(settings.framesInFlight);
+
+        // Offscreen images belong to a single frame, so they're free once its fence has signalled.
+        if (headless)
+        {
+            *imageIndex = static_cast<u32>(currentFrame);
+            return VK_SUCCESS;
+        }
+
         // Once available, Add it to our available images semaphor for usage
         return vkAcquireNextImageKHR(
             device.Device(),
@@ -313,6 +491,8 @@ namespace SnekVk
 
     VkResult SwapChain::SubmitCommandBuffers(const VkCommandBuffer* buffers, u32* imageIndex)
     {
+        CPU_PROFILE_SCOPE("SwapChain::SubmitCommandBuffers");
+
         u32 index = *imageIndex;
 
         // If the image being asked for is being used, we wait for it to become available
@@ -337,7 +517,8 @@ namespace SnekVk
         // Set a stage that you need to wait for. In this case we wait until the color stage of the pipeline is done (fragment stage)
         VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 
-        submitInfo.waitSemaphoreCount = 1;
+        // Offscreen images aren't acquired or presented, so there's nothing to wait on or signal.
+        submitInfo.waitSemaphoreCount = headless ? 0 : 1;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
 
@@ -346,7 +527,7 @@ namespace SnekVk
 
         // Specify some semaphores to be signalled when rendering is done
         VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.signalSemaphoreCount = headless ? 0 : 1;
         submitInfo.pSignalSemaphores = signalSemaphores;
         
         // Reset the fence of this frame
@@ -356,6 +537,17 @@ namespace SnekVk
         SNEK_ASSERT(vkQueueSubmit(device.GraphicsQueue(), 1, &submitInfo, OUT inFlightFences[currentFrame]) == VK_SUCCESS,
             "Failed to submit draw command buffer");
 
+        // Presentation can block, so the submit time is recorded before it.
+        lastSubmitTime = std::chrono::steady_clock::now();
+
+        DeletionQueue::AdvanceFrame();
+
+        if (headless)
+        {
+            currentFrame = (currentFrame + 1) % settings.framesInFlight;
+            return VK_SUCCESS;
+        }
+
         // Set up our presentation information and the semaphores to wait on
         VkPresentInfoKHR presentInfo{};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -376,7 +568,7 @@ namespace SnekVk
         auto result = vkQueuePresentKHR(device.PresentQueue(), &presentInfo);
 
         // Set the frame to the next frame
-        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        currentFrame = (currentFrame + 1) % settings.framesInFlight;
 
         // Return the result of the rendering process
         return result;
@@ -399,21 +591,22 @@ namespace SnekVk
 
     VkPresentModeKHR SwapChain::ChoosePresentMode(VkPresentModeKHR* presentModes, size_t presentModeCount)
     {
+        static const char* presentModeNames[] = { "Immediate", "Mailbox", "V-Sync", "Relaxed V-Sync" };
+
+        auto requestedMode = static_cast<VkPresentModeKHR>(settings.presentMode);
+
         for (size_t i = 0; i < presentModeCount; i++)
         {
-            VkPresentModeKHR& availablePresentMode = presentModes[i];
-
-            // Ideally, we want to support triple buffering since it has the best 
-            // balance between performance and image quality
-            if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+            if (presentModes[i] == requestedMode)
             {
-                std::cout << "Present Mode: Mailbox" << std::endl;
-                return availablePresentMode;
+                SNEK_LOG_INFO("Present Mode: " << presentModeNames[settings.presentMode]);
+                return requestedMode;
             }
         }
 
-        // If triple buffering is not available then use v-sync
-        std::cout << "Present Mode: V-Sync" << std::endl;
+        // FIFO is the only mode the spec guarantees, so fall back to v-sync.
+        SNEK_LOG_WARNING("Present Mode: " << presentModeNames[settings.presentMode] 
+                         << " not supported, falling back to V-Sync");
         return VK_PRESENT_MODE_FIFO_KHR;
     }
 
@@ -4,6 +4,9 @@
 #include "../RenderPass/RenderPass.h"
 #include "../Image/FrameImages.h"
 
+#include <vector>
+#include <chrono>
+
 namespace SnekVk
 {
     /**
@@ -28,10 +31,34 @@ namespace SnekVk
 
         /** 
          *  When swapping out images for our frames, we can have multiple frames 'in flight', 
-         *  meaning frames that act as additional memory buffers. In our case we allow for two additional
-         *  frames in flight for added image buffering.
+         *  meaning frames that act as additional memory buffers. More frames in flight improve 
+         *  throughput at the cost of input latency. 
          **/
-        static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+        static constexpr u32 MAX_FRAMES_IN_FLIGHT = 3;
+
+        /**
+         * @brief The method used to present images to the screen. Values match their VkPresentModeKHR equivalents. 
+         */
+        enum PresentMode
+        {
+            // Images are presented immediately. Uncapped, but may tear. 
+            IMMEDIATE = 0,
+            // Triple buffering. New images replace queued ones without blocking.
+            MAILBOX = 1,
+            // V-sync. Always supported.
+            FIFO = 2,
+            // V-sync, but late images are presented immediately instead of waiting for the next blank.
+            FIFO_RELAXED = 3
+        };
+
+        /**
+         * @brief Runtime swapchain configuration. Changes are applied when the swapchain is next re-created.
+         */
+        struct Settings
+        {
+            u32 framesInFlight = 2;
+            PresentMode presentMode = MAILBOX;
+        };
 
         // 'Structors 
 
@@ -79,6 +106,27 @@ namespace SnekVk
          */
         VkFramebuffer GetFrameBuffer(u32 i) { return swapChainFrameBuffers[i]; }
 
+        /**
+         * @brief Get the color image corresponding to index i.
+         * 
+         * @param i the index of the image. Must be less than the swapchain's image count.
+         * @return VkImage the color image in index i.
+         */
+        VkImage GetImage(u32 i) { return swapchainImages.GetImage(i); }
+
+        /**
+         * @brief Returns the layout that color images are left in once a frame has been rendered.
+         */
+        VkImageLayout GetImageLayout() const 
+        { 
+            return headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; 
+        }
+
+        /**
+         * @brief Returns true if color images can be copied from. 
+         */
+        bool SupportsReadback() const { return supportsReadback; }
+
         /**
          * @brief Get the number of images that can be active at once. 
          * 
@@ -118,6 +166,57 @@ namespace SnekVk
 
         void SetWindowExtents(VkExtent2D windowExtent);
 
+        /**
+         * @brief Initialises the swapchain without a window surface. Rather than presenting, frames are 
+         * rendered into offscreen color images owned by the swapchain, one per frame in flight. The same 
+         * render pass, depth images and framebuffers are used as when rendering to a window, except that 
+         * color images finish in the transfer source layout so that they can be read back. 
+         * 
+         * @param extent the resolution of the offscreen images.
+         */
+        void InitialiseHeadless(VkExtent2D extent);
+
+        /**
+         * @brief Returns true if frames are being rendered offscreen. 
+         */
+        bool IsHeadless() const { return headless; }
+
+        /**
+         * @brief Sets the swapchain's settings. These are applied when the swapchain is next created. 
+         * 
+         * @param settings the new settings. Frames in flight must be between 1 and MAX_FRAMES_IN_FLIGHT.
+         */
+        void SetSettings(const Settings& settings);
+
+        /**
+         * @brief Returns the settings currently in use by the swapchain.
+         */
+        const Settings& GetSettings() const { return settings; }
+
+        /**
+         * @brief Returns the settings which will be applied when the swapchain is next re-created.
+         */
+        const Settings& GetPendingSettings() const { return pendingSettings; }
+
+        /**
+         * @brief Returns true if settings have been changed since the swapchain was last created.
+         */
+        bool HasPendingSettings() const 
+        { 
+            return pendingSettings.framesInFlight != settings.framesInFlight 
+                || pendingSettings.presentMode != settings.presentMode; 
+        }
+
+        /**
+         * @brief Returns the number of frames which can be recorded while others are still rendering.
+         */
+        u32 GetFramesInFlight() const { return settings.framesInFlight; }
+
+        /**
+         * @brief Returns the time at which the last command buffer was submitted to the graphics queue.
+         */
+        std::chrono::steady_clock::time_point GetLastSubmitTime() const { return lastSubmitTime; }
+
         /**
          * @brief Loads in the next image to be written to in the Swapchain. 
          * 
@@ -135,6 +234,12 @@ namespace SnekVk
          */
         VkResult SubmitCommandBuffers(const VkCommandBuffer* buffers, u32* imageIndex);
 
+        /**
+         * @brief Re-creates the swapchain for the current window extents. The old swapchain is passed to
+         * the new one and its resources are retired rather than destroyed, since frames in flight may still 
+         * be using them. The render pass and synchronisation objects are kept unless the surface formats 
+         * or frames in flight change, in which case the device is idled and they are re-created.
+         */
         void RecreateSwapchain();
 
         bool CompareSwapFormats(VkFormat oldImageFormat, VkFormat oldDepthFormat);
@@ -188,6 +293,11 @@ namespace SnekVk
          */
         void CreateSyncObjects();
 
+        /**
+         * @brief Destroys all synchronisation objects and their storage. 
+         */
+        void DestroySyncObjects();
+
         /**
          * @brief Specifies which color format we want images to be written to. Accepts a set of formats
          * and populates them with requisite data. 
@@ -222,9 +332,36 @@ namespace SnekVk
          */
         VkFormat FindDepthFormat();
 
-        void ClearSwapChain(bool isRecreated = false);
+        void ClearSwapChain();
         void ClearMemory();
 
+        /**
+         * @brief Holds all resources belonging to a previous swapchain. 
+         */
+        struct RetiredResources
+        {
+            VkSwapchainKHR swapChain {VK_NULL_HANDLE};
+            u32 imageCount = 0;
+            VkFramebuffer frameBuffers[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            VkImageView colorImageViews[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            VkImageView depthImageViews[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            VkImage depthImages[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            VkDeviceMemory depthImageMemorys[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            // Only populated for offscreen images. Swapchain images are owned by the swapchain.
+            VkImage colorImages[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+            VkDeviceMemory colorImageMemorys[FrameImages::MAX_IMAGES] {VK_NULL_HANDLE};
+        };
+
+        /**
+         * @brief Hands the current swapchain's resources to the deletion queue. They are destroyed
+         * once all frames which used them have completed.
+         */
+        void RetireResources();
+
+        static void DestroyRetiredResources(VkDevice device, const RetiredResources& resources);
+
+        void CreateImagesInFlight();
+
         // Device and window data
         VulkanDevice& device;
         VkExtent2D windowExtent;
@@ -256,5 +393,13 @@ namespace SnekVk
         VkFence* inFlightFences {VK_NULL_HANDLE};
         VkFence* imagesInFlight {VK_NULL_HANDLE};
         size_t currentFrame = 0;
+
+        Settings settings;
+        Settings pendingSettings;
+
+        std::chrono::steady_clock::time_point lastSubmitTime;
+
+        bool headless {false};
+        bool supportsReadback {false};
     };
 }
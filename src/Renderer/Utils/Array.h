@@ -148,6 +148,7 @@ namespace SnekVk::Utils
         const T& operator[] (size_t index) const { return data[index]; }
 
         T* Data() { return data; }
+        const T* Data() const { return data; }
 
         Iterator begin() { return Iterator(data); }
         Iterator end() { return Iterator(data + size); }
@@ -1,23 +1,238 @@
 #include "Hash.h"
 
+#ifdef DEBUG
+#include "../Logging/Logger.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#endif
+
 namespace SnekVk::Utils
 {
-    // Constexpr implementation and helpers
-    uint32_t crc32_impl(const uint8_t* p, size_t len, uint32_t crc) {
-        return len ?
-               crc32_impl(p+1,len-1,(crc>>8)^crc_table[(crc&0xFF)^*p])
-                   : crc;
+    // Slicing-by-8 tables. Table 0 is the standard byte-wise table, and each following table advances
+    // the CRC of a byte by one more zero byte, so eight bytes can be folded in with independent lookups.
+    struct Crc32Tables
+    {
+        uint32_t values[8][256] {};
+    };
+
+    static constexpr Crc32Tables GenerateCrc32Tables()
+    {
+        Crc32Tables tables;
+
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+
+            tables.values[0][i] = crc;
+        }
+
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (int table = 1; table < 8; table++)
+            {
+                uint32_t previous = tables.values[table - 1][i];
+                tables.values[table][i] = (previous >> 8) ^ tables.values[0][previous & 0xFF];
+            }
+        }
+
+        return tables;
+    }
+
+    static constexpr Crc32Tables crc32Tables = GenerateCrc32Tables();
+
+    static constexpr bool MatchesCrcTable(const Crc32Tables& tables)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            if (tables.values[0][i] != crc_table[i]) return false;
+        }
+
+        return true;
+    }
+
+    static_assert(MatchesCrcTable(crc32Tables), "Slicing-by-8 tables must match the constexpr CRC table");
+
+    static inline uint32_t ReadU32(const uint8_t* p)
+    {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    static inline uint64_t ReadU64(const uint8_t* p)
+    {
+        return uint64_t(ReadU32(p)) | (uint64_t(ReadU32(p + 4)) << 32);
+    }
+
+    uint32_t Crc32Sliced(const void* data, size_t length)
+    {
+        auto& t = crc32Tables.values;
+
+        auto p = static_cast<const uint8_t*>(data);
+        uint32_t crc = ~0u;
+
+        for (; length >= 8; length -= 8, p += 8)
+        {
+            uint32_t one = ReadU32(p) ^ crc;
+            uint32_t two = ReadU32(p + 4);
+
+            crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+                  t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        }
+
+        return ~crc32_impl(p, length, crc);
+    }
+
+    // XXH64, from: https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+    static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+    static inline uint64_t RotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static inline uint64_t Round(uint64_t accumulator, uint64_t lane)
+    {
+        accumulator += lane * PRIME64_2;
+        accumulator = RotateLeft(accumulator, 31);
+        return accumulator * PRIME64_1;
+    }
+
+    static inline uint64_t MergeRound(uint64_t hash, uint64_t accumulator)
+    {
+        hash ^= Round(0, accumulator);
+        return hash * PRIME64_1 + PRIME64_4;
+    }
+
+    uint64_t Hash64(const void* data, size_t length, uint64_t seed)
+    {
+        auto p = static_cast<const uint8_t*>(data);
+        auto end = p + length;
+
+        uint64_t hash;
+
+        if (length >= 32)
+        {
+            uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+            uint64_t v2 = seed + PRIME64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - PRIME64_1;
+
+            for (; p + 32 <= end; p += 32)
+            {
+                v1 = Round(v1, ReadU64(p));
+                v2 = Round(v2, ReadU64(p + 8));
+                v3 = Round(v3, ReadU64(p + 16));
+                v4 = Round(v4, ReadU64(p + 24));
+            }
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else hash = seed + PRIME64_5;
+
+        hash += static_cast<uint64_t>(length);
+
+        for (; p + 8 <= end; p += 8)
+        {
+            hash ^= Round(0, ReadU64(p));
+            hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+        }
+
+        if (p + 4 <= end)
+        {
+            hash ^= uint64_t(ReadU32(p)) * PRIME64_1;
+            hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+            p += 4;
+        }
+
+        for (; p < end; p++)
+        {
+            hash ^= (*p) * PRIME64_5;
+            hash = RotateLeft(hash, 11) * PRIME64_1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME64_2;
+        hash ^= hash >> 29;
+        hash *= PRIME64_3;
+        hash ^= hash >> 32;
+
+        return hash;
     }
 
-    uint32_t crc32(const uint8_t* data, size_t length) {
-        return ~crc32_impl(data, length, ~0);
+    StringId WSID(const char* str)
+    {
+        return Crc32Sliced(str, std::strlen(str));
     }
 
-    size_t strlen_c(const char* str) {
-        return *str ? 1+strlen_c(str+1) : 0;
+    #ifdef DEBUG
+
+    static std::unordered_map<StringId, std::string>& InternedStrings()
+    {
+        static std::unordered_map<StringId, std::string> strings;
+        return strings;
     }
 
-    StringId WSID(const char* str) {
-        return crc32((uint8_t*)str, strlen_c(str));
+    static std::mutex internMutex;
+
+    StringId InternString(const char* str)
+    {
+        StringId id = WSID(str);
+
+        std::lock_guard<std::mutex> lock(internMutex);
+
+        auto result = InternedStrings().emplace(id, str);
+
+        if (!result.second && result.first->second != str)
+        {
+            SNEK_LOG_WARNING("String ID collision between '" << result.first->second
+                             << "' and '" << str << "'");
+        }
+
+        return id;
     }
+
+    StringId RegisterStringId(StringId id, const char* str)
+    {
+        if (InternString(str) != id) SNEK_LOG_WARNING("String ID " << id << " was registered as '" << str << "'");
+
+        return id;
+    }
+
+    const char* LookupStringId(StringId id)
+    {
+        std::lock_guard<std::mutex> lock(internMutex);
+
+        auto it = InternedStrings().find(id);
+
+        return it == InternedStrings().end() ? nullptr : it->second.c_str();
+    }
+
+    #else
+
+    StringId InternString(const char* str)
+    {
+        return WSID(str);
+    }
+
+    StringId RegisterStringId(StringId id, const char*)
+    {
+        return id;
+    }
+
+    const char* LookupStringId(StringId)
+    {
+        return nullptr;
+    }
+
+    #endif
 }
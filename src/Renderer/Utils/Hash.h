@@ -3,6 +3,7 @@
 #include <functional>
 #include <cstring>
 #include <cstdint>
+#include <string>
 
 namespace SnekVk::Utils
 {
@@ -13,6 +14,17 @@ namespace SnekVk::Utils
         (HashCombine(seed, rest), ...);
     };
 
+    /**
+     * @brief Appends the raw bytes of each value to a key. Keys built this way are compared in full,
+     * so unlike a hash they can't collide. Values should be scalars so that no struct padding ends up
+     * in the key.
+     */
+    template <typename... Ts>
+    void AppendKey(std::string& key, const Ts&... values)
+    {
+        (key.append(reinterpret_cast<const char*>(&values), sizeof(values)), ...);
+    }
+
     typedef uint32_t StringId;
 
     // CRC hash generation
@@ -33,11 +45,76 @@ namespace SnekVk::Utils
     constexpr unsigned crc_table[] = { A(0) };
 
     // Constexpr implementation and helpers
-    uint32_t crc32_impl(const uint8_t* p, size_t len, uint32_t crc);
+    template <typename Byte>
+    constexpr uint32_t crc32_impl(const Byte* p, size_t len, uint32_t crc)
+    {
+        for (size_t i = 0; i < len; i++) crc = (crc >> 8) ^ crc_table[(crc & 0xFF) ^ static_cast<uint8_t>(p[i])];
+
+        return crc;
+    }
+
+    constexpr uint32_t crc32(const uint8_t* data, size_t length)
+    {
+        return ~crc32_impl(data, length, ~0u);
+    }
+
+    constexpr uint32_t crc32(const char* data, size_t length)
+    {
+        return ~crc32_impl(data, length, ~0u);
+    }
+
+    constexpr size_t strlen_c(const char* str)
+    {
+        size_t length = 0;
+        while (str[length]) length++;
+
+        return length;
+    }
 
-    uint32_t crc32(const uint8_t* data, size_t length);
+    /**
+     * @brief Computes the same CRC32 as crc32(), eight bytes at a time using slicing-by-8 tables.
+     * Use this for strings and buffers only known at runtime.
+     */
+    uint32_t Crc32Sliced(const void* data, size_t length);
 
-    size_t strlen_c(const char* str);
+    /**
+     * @brief A fast, non-cryptographic 64-bit hash (XXH64). Suited to cache keys over large buffers
+     * such as file contents, where 32 bits would make collisions likely.
+     */
+    uint64_t Hash64(const void* data, size_t length, uint64_t seed = 0);
 
     StringId WSID(const char* str);
-}
\ No newline at end of file
+
+    /**
+     * @brief Hashes a string at runtime. In debug builds the string is also recorded, so that the
+     * ID can be turned back into a readable name and collisions between names are reported.
+     */
+    StringId InternString(const char* str);
+
+    /**
+     * @brief Records the name of an ID created with _sid, which the compiler hashes without interning.
+     * In debug builds this lets the ID be looked up by name, and reports names which don't match the ID.
+     *
+     * @returns the ID, unchanged.
+     */
+    StringId RegisterStringId(StringId id, const char* str);
+
+    /**
+     * @brief Finds the string an ID was interned from.
+     *
+     * @returns the interned string, or nullptr if the ID is unknown. Always nullptr in release builds.
+     */
+    const char* LookupStringId(StringId id);
+}
+
+namespace SnekVk
+{
+    /**
+     * @brief Creates a string ID from a literal, i.e: "globalData"_sid. Identical to INTERN_STR, but
+     * evaluated at compile time when used in a constant expression.
+     */
+    constexpr Utils::StringId operator""_sid(const char* str, size_t length)
+    {
+        return Utils::crc32(str, length);
+    }
+}
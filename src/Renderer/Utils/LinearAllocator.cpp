@@ -0,0 +1,72 @@
+#include "LinearAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+namespace SnekVk::Utils
+{
+    LinearAllocator::LinearAllocator(size_t chunkSize) : chunkSize{chunkSize} {}
+
+    LinearAllocator::~LinearAllocator()
+    {
+        Release();
+    }
+
+    void* LinearAllocator::Allocate(size_t size, size_t alignment)
+    {
+        assert((alignment & (alignment - 1)) == 0 && "Error: alignment must be a power of two!");
+
+        if (!chunks.empty())
+        {
+            auto& chunk = chunks.back();
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(chunk.memory) + chunk.offset;
+            size_t padding = (alignment - (address % alignment)) % alignment;
+
+            if (chunk.offset + padding + size <= chunk.size)
+            {
+                chunk.offset += padding + size;
+                bytesAllocated += size;
+                return reinterpret_cast<void*>(address + padding);
+            }
+        }
+
+        // Grow geometrically so that the number of chunks stays logarithmic in the total size.
+        AddChunk(std::max({chunkSize, capacity, size + alignment}));
+
+        return Allocate(size, alignment);
+    }
+
+    void LinearAllocator::Reset()
+    {
+        if (chunks.size() > 1)
+        {
+            size_t totalSize = capacity;
+            Release();
+            AddChunk(totalSize);
+        }
+        else if (!chunks.empty()) chunks.back().offset = 0;
+
+        bytesAllocated = 0;
+    }
+
+    void LinearAllocator::Release()
+    {
+        for (auto& chunk : chunks) std::free(chunk.memory);
+
+        chunks.clear();
+        capacity = 0;
+        bytesAllocated = 0;
+    }
+
+    void LinearAllocator::AddChunk(size_t size)
+    {
+        auto* memory = static_cast<uint8_t*>(std::malloc(size));
+
+        assert(memory && "Error: failed to allocate memory for linear allocator!");
+
+        chunks.push_back({memory, size, 0});
+        capacity += size;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SnekVk::Utils
+{
+    /**
+     * @brief A bump allocator which hands out memory from a list of chunks. Allocations are never freed
+     * individually, instead the whole allocator is reset at once. When a chunk runs out of space a new one
+     * is added, at least as large as everything allocated so far. On reset, multiple chunks are merged into
+     * a single chunk of their combined size, so that a steady workload settles into one contiguous block.
+     */
+    class LinearAllocator
+    {
+        public:
+
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        LinearAllocator(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+        ~LinearAllocator();
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        /**
+         * @brief Allocates a block of memory. The memory stays valid until the allocator is reset.
+         *
+         * @param size the size of the block in bytes.
+         * @param alignment the alignment of the block. Must be a power of two.
+         * @returns a pointer to the (uninitialised) block.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        T* Allocate(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Invalidates all allocations, keeping the memory for re-use.
+         */
+        void Reset();
+
+        /**
+         * @brief Invalidates all allocations and frees all memory.
+         */
+        void Release();
+
+        size_t BytesAllocated() const { return bytesAllocated; }
+        size_t Capacity() const { return capacity; }
+
+        private:
+
+        struct Chunk
+        {
+            uint8_t* memory = nullptr;
+            size_t size = 0;
+            size_t offset = 0;
+        };
+
+        void AddChunk(size_t size);
+
+        std::vector<Chunk> chunks;
+        size_t chunkSize;
+        size_t capacity {0};
+        size_t bytesAllocated {0};
+    };
+}
@@ -0,0 +1,145 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SnekVk::Utils
+{
+    MappedFile::MappedFile(const char* filePath)
+    {
+        Open(filePath);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    #if defined(_WIN32) || defined(_WIN64)
+
+    bool MappedFile::Open(const char* filePath)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        isOpen = true;
+
+        // Empty files can't be mapped.
+        if (fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (!mapping)
+        {
+            isOpen = false;
+            return false;
+        }
+
+        // The view keeps the mapping alive, so the handle isn't needed once it's been created.
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (!view)
+        {
+            isOpen = false;
+            return false;
+        }
+
+        data = static_cast<const char*>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (data) UnmapViewOfFile(data);
+
+        data = nullptr;
+        size = 0;
+        isOpen = false;
+    }
+
+    #else
+
+    bool MappedFile::Open(const char* filePath)
+    {
+        Close();
+
+        int file = open(filePath, O_RDONLY);
+
+        if (file < 0) return false;
+
+        struct stat fileStats;
+
+        if (fstat(file, &fileStats) != 0)
+        {
+            close(file);
+            return false;
+        }
+
+        isOpen = true;
+
+        // Empty files can't be mapped.
+        if (fileStats.st_size == 0)
+        {
+            close(file);
+            return true;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping holds its own reference to the file.
+        close(file);
+
+        if (view == MAP_FAILED)
+        {
+            isOpen = false;
+            return false;
+        }
+
+        data = static_cast<const char*>(view);
+        size = static_cast<size_t>(fileStats.st_size);
+
+        // Files are generally read in full, so start paging the whole file in straight away.
+        madvise(view, size, MADV_WILLNEED);
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (data) munmap(const_cast<char*>(data), size);
+
+        data = nullptr;
+        size = 0;
+        isOpen = false;
+    }
+
+    #endif
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+namespace SnekVk::Utils
+{
+    /**
+     * @brief A read-only view of a file's contents, mapped into memory by the OS. Pages are only read from
+     * disk as they're touched, and can be read from multiple threads at once. The view is unmapped when
+     * the MappedFile is destroyed.
+     */
+    class MappedFile
+    {
+        public:
+
+        MappedFile() = default;
+        MappedFile(const char* filePath);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file, unmapping any file which was previously opened.
+         *
+         * @param filePath the path of the file.
+         * @returns true if the file could be mapped. Empty files are opened, but have no data.
+         */
+        bool Open(const char* filePath);
+
+        void Close();
+
+        bool IsOpen() const { return isOpen; }
+
+        const char* Data() const { return data; }
+        size_t Size() const { return size; }
+
+        private:
+
+        const char* data {nullptr};
+        size_t size {0};
+        bool isOpen {false};
+    };
+}
@@ -6,131 +6,118 @@
 #include <cstdint>
 #include <cassert>
 #include <cstring>
+#include <initializer_list>
 
 namespace SnekVk::Utils
 {
+    /**
+     * @brief A vector with a fixed capacity, stored inline. Elements are always contiguous, so clearing the
+     * array is O(1) and iteration never has to skip empty slots.
+     */
     template<typename T, size_t S>
     class StackArray
     {
         public:
         using ValueType = T;
-        using Iterator = ArrayIterator<StackArray<T, S>>;
+        using Iterator = T*;
+        using ConstIterator = const T*;
 
-        public: 
+        public:
 
-        StackArray() { memset(states, false, sizeof(bool) * S); }
+        StackArray() {}
 
         StackArray(std::initializer_list<T> values)
         {
             for(auto& value : values) Append(value);
         }
 
-        StackArray(StackArray<T, S>& other)
+        StackArray(const StackArray<T, S>& other)
         {
             for(auto& value : other) Append(value);
         }
 
+        StackArray<T, S>& operator=(const StackArray<T, S>& other)
+        {
+            if (this == &other) return *this;
+
+            count = 0;
+            for(auto& value : other) Append(value);
+
+            return *this;
+        }
+
         ~StackArray() {}
 
-        size_t Count() { return count; }
         size_t Count() const { return count; }
-        size_t Size() { return S; }
+        size_t Size() const { return S; }
+        bool Empty() const { return count == 0; }
+        bool Full() const { return count == S; }
+
         T* Data() { return data; }
         const T* Data() const { return data; }
-        
-        void Set(size_t index, T value)
+
+        void Append(const T& value)
         {
-            count += !Exists(index);
+            assert(count < S && "Too many elements added to array!");
 
-            states[index] = true; 
-            data[index] = value;
+            data[count++] = value;
         }
 
-        void Append(T value)
+        /**
+         * @brief Appends a default constructed element and returns a reference to it.
+         */
+        T& Append()
         {
-            assert(count < S 
-                    && std::string("Too many elements added to array. Max is ")
-                    .append(std::to_string(S)).c_str());
-            Activate(count);
-            Set(count-1, value);
+            assert(count < S && "Too many elements added to array!");
+
+            data[count] = T{};
+            return data[count++];
         }
 
-        void Remove(size_t index)
+        /**
+         * @brief Removes the last element.
+         */
+        void Pop()
         {
-            if (!Exists(index)) return;
+            assert(count > 0 && "Error: trying to pop from an empty array");
 
-            states[index] = false;
             count--;
         }
 
         T& Get(size_t index)
         {
-            assert(Exists(index) && "Error: trying to access empty element");
+            assert(index < count && "Error: index is out of bounds!");
 
             return data[index];
         }
 
-        T& operator[] (size_t index) { return Get(index); }
-
-        const T& operator[] (size_t index) const { return Get(index); }
-
-        Iterator begin() { return Iterator(&data[0]); }
-        Iterator end() { return Iterator(&data[count]); }
-
-        const Iterator begin() const { return Iterator(&data[0]); }
-        const Iterator end() const { return Iterator(&data[count]); }
-
-        bool Exists(size_t index)
+        const T& Get(size_t index) const
         {
-            assert(isValidIndex(index) && "Error: index is out of bounds!");
+            assert(index < count && "Error: index is out of bounds!");
 
-            return states[index];
-        }
-
-        void Activate(size_t index)
-        {
-            assert(isValidIndex(index) && "Error: index is out of bounds!");
-
-            states[index] = true;
-
-            count++;
+            return data[index];
         }
 
-        void Allocate(size_t slots)
-        {
-            assert(slots < S && count + slots < S && "Error: trying to allocate more slots than actually exist");
+        T& Back() { return Get(count - 1); }
+        const T& Back() const { return Get(count - 1); }
 
-            for (size_t i = 0; i < slots; i++)
-            {
-                Activate(i);
-            }
-        }
+        T& operator[] (size_t index) { return Get(index); }
+        const T& operator[] (size_t index) const { return Get(index); }
 
-        void Allocate(size_t slots, T defaultValue)
-        {
-            assert(slots < S && count + slots < S && "Error: trying to allocate more slots than actually exist");
+        Iterator begin() { return data; }
+        Iterator end() { return data + count; }
 
-            for (size_t i = 0; i < slots; i++)
-            {
-                Set(i, defaultValue);
-            }
-        }
+        ConstIterator begin() const { return data; }
+        ConstIterator end() const { return data + count; }
 
-        void Clear()
-        {
-            count = 0;
-            memset(states, false, sizeof(bool) * S);
-        }
+        /**
+         * @brief Empties the array. Elements aren't destroyed, they're simply overwritten by later appends.
+         */
+        void Clear() { count = 0; }
 
         private:
 
-        bool isValidIndex(size_t index)
-        {
-            return index < S;
-        }
-
-        bool states[S];
         T data[S];
-        size_t count {0}; 
+        size_t count {0};
     };
-}
\ No newline at end of file
+}
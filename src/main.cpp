@@ -7,6 +7,7 @@
 #include "Input/Input.h"
 #include "Utils/Math.h"
 #include "Renderer/Material/Material.h"
+#include "Renderer/Material/MaterialInstance.h"
 #include "Renderer/Shader/Shader.h"
 #include "Renderer/Lights/PointLight.h"
 
@@ -225,7 +226,8 @@ int main()
     auto diffuseFragShader = SnekVk::Shader::BuildShader()
         .FromShader("shaders/diffuseFragShader.frag.spv")
         .WithStage(SnekVk::PipelineConfig::FRAGMENT)
-        .WithUniform(1, "globalData", sizeof(SnekVk::Renderer3D::GlobalData)); // TIL: bindings must be unique accross all available shaders 
+        .WithUniform(1, "globalData", sizeof(SnekVk::Renderer3D::GlobalData)) // TIL: bindings must be unique accross all available shaders 
+        .WithStorage(2, "instanceData", sizeof(glm::vec4), 100);
 
     // Material Declaration
                                 // vertex       // fragment  
@@ -234,8 +236,17 @@ int main()
 
     //SnekVk::Material pointLightMat(&pointLightVertShader, &pointLightFragShader); // point light shader
 
+    // Each diffuse material instance gets its own tint.
+    diffuseMat.SetInstanceParameters("instanceData", sizeof(glm::vec4));
+
     SnekVk::Material::BuildMaterials({&diffuseMat, &spriteMat});
 
+    // Material instances share the diffuse pipeline.
+    SnekVk::MaterialInstance greenDiffuse(&diffuseMat);
+
+    glm::vec4 greenTint {.2f, 1.f, .2f, 1.f};
+    greenDiffuse.SetParameters(sizeof(greenTint), &greenTint);
+
     // Generate models
 
     // Generating models from raw vertices
@@ -300,14 +311,12 @@ int main()
 
     renderer.SetMainCamera(&camera);
 
-    while(!window.WindowShouldClose()) {
-        
+    // Input is sampled by the renderer once the frame's fence has been waited on.
+    renderer.EnableLowLatencyMode([&]() {
         auto newTime = std::chrono::high_resolution_clock::now();
         float frameTime = std::chrono::duration<float, std::chrono::seconds::period>(newTime - currentTime).count();
         currentTime = newTime;
 
-        auto alpha = std::clamp<float>(abs(sin(glfwGetTime())), 0.001f, 1.f);
-
         window.Update();
 
         if (Input::IsKeyJustPressed(KEY_ESCAPE)) 
@@ -325,6 +334,11 @@ int main()
             MoveCameraXZ(frameTime, cameraObject);
             camera.SetViewYXZ(cameraObject.GetPosition(), cameraObject.GetRotation());
         }
+    });
+
+    while(!window.WindowShouldClose()) {
+
+        auto alpha = std::clamp<float>(abs(sin(glfwGetTime())), 0.001f, 1.f);
 
         if (!renderer.StartFrame()) continue;
         
@@ -333,6 +347,8 @@ int main()
             SnekVk::Renderer3D::DrawModel(shape.GetModel(), shape.GetPosition(), shape.GetScale(), shape.GetRotation());
         }
 
+        SnekVk::Renderer3D::DrawModel(&cubeObjModel, &greenDiffuse, {1.5f, -.5f, 0.f}, {.5f, .5f, .5f}, {0.f, 0.f, 0.f});
+
         // TODO(Aryeh): This will eventually need to take in multiple lights.
         SnekVk::Renderer3D::DrawPointLight({0.0f, -1.f, -1.5f}, 0.05f, {1.f, 0.f, 0.f, alpha}, {1.f, 1.f, 1.f, .02f});
         
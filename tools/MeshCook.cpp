@@ -0,0 +1,98 @@
+#include "Renderer/Model/MeshCache.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Builds mesh cache files ahead of time, so that models don't need to be parsed the first time the app
+ * loads them. Cache files are written alongside the models unless an output directory is given.
+ */
+
+struct Options
+{
+    std::string outputDirectory;
+    bool optimise {true};
+    std::vector<const char*> sourcePaths;
+};
+
+static void PrintUsage()
+{
+    std::cout << "Usage: meshcook [options] <model.obj>...\n"
+              << "  --output <directory>  where to write cache files (default: next to each model)\n"
+              << "  --no-optimise         don't reorder meshes for the vertex cache and overdraw" << std::endl;
+}
+
+static bool ParseOptions(int argc, char** argv, OUT Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help") return false;
+        if (arg == "--no-optimise") { options.optimise = false; continue; }
+
+        if (arg == "--output")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "Missing value for " << arg << std::endl;
+                return false;
+            }
+
+            options.outputDirectory = argv[++i];
+            continue;
+        }
+
+        options.sourcePaths.push_back(argv[i]);
+    }
+
+    return !options.sourcePaths.empty();
+}
+
+static std::string GetOutputPath(const Options& options, const char* sourcePath)
+{
+    if (options.outputDirectory.empty()) return SnekVk::MeshCache::GetCachePath(sourcePath);
+
+    std::string fileName = sourcePath;
+    size_t separator = fileName.find_last_of("/\\");
+
+    if (separator != std::string::npos) fileName = fileName.substr(separator + 1);
+
+    return SnekVk::MeshCache::GetCachePath((options.outputDirectory + "/" + fileName).c_str());
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, OUT options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    u32 flags = options.optimise ? SnekVk::MeshCache::FLAG_OPTIMISED : 0;
+    int failures = 0;
+
+    for (auto sourcePath : options.sourcePaths)
+    {
+        std::string cachePath = GetOutputPath(options, sourcePath);
+        std::string error;
+
+        if (SnekVk::MeshCache::Cook(sourcePath, cachePath.c_str(), flags, OUT error))
+        {
+            // Optimisation statistics are logged, so they're written out before the result.
+            SnekVk::Logger::Flush();
+            std::cout << sourcePath << " -> " << cachePath << std::endl;
+        }
+        else
+        {
+            std::cout << sourcePath << ": " << error << std::endl;
+            failures++;
+        }
+    }
+
+    SnekVk::Logger::Flush();
+
+    return failures == 0 ? 0 : 1;
+}